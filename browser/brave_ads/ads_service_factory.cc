@@ -17,6 +17,7 @@
 #if BUILDFLAG(BRAVE_ADS_ENABLED)
 #include "brave/browser/brave_rewards/rewards_service_factory.h"
 #include "brave/components/brave_ads/browser/ads_service_impl.h"
+#include "brave/components/weekly_storage/weekly_storage_registry_factory.h"
 #include "chrome/browser/dom_distiller/dom_distiller_service_factory.h"
 #include "chrome/browser/history/history_service_factory.h"
 #include "chrome/browser/notifications/notification_display_service_factory.h"
@@ -49,6 +50,7 @@ AdsServiceFactory::AdsServiceFactory()
   DependsOn(dom_distiller::DomDistillerServiceFactory::GetInstance());
   DependsOn(brave_rewards::RewardsServiceFactory::GetInstance());
   DependsOn(HistoryServiceFactory::GetInstance());
+  DependsOn(WeeklyStorageRegistryFactory::GetInstance());
 #endif
 }
 
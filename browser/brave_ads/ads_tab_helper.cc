@@ -5,17 +5,16 @@
 
 #include "brave/browser/brave_ads/ads_tab_helper.h"
 
-#include <memory>
 #include <utility>
 
+#include "base/memory/read_only_shared_memory_region.h"
 #include "brave/browser/brave_ads/ads_service_factory.h"
 #include "chrome/browser/profiles/profile.h"
-#include "components/dom_distiller/content/browser/distiller_javascript_utils.h"
-#include "components/dom_distiller/content/browser/distiller_page_web_contents.h"
 #include "components/sessions/content/session_tab_helper.h"
 #include "content/public/browser/navigation_handle.h"
 #include "content/public/browser/render_frame_host.h"
 #include "content/public/browser/web_contents.h"
+#include "third_party/blink/public/common/associated_interfaces/associated_interface_provider.h"
 #include "ui/base/page_transition_types.h"
 #include "ui/base/resource/resource_bundle.h"
 
@@ -27,6 +26,15 @@
 
 namespace brave_ads {
 
+namespace {
+
+// Page text is truncated in the renderer to the maximum length of text
+// processed by the text classifier, so that the text of large documents is not
+// collected only to be discarded
+const uint32_t kMaximumPageTextLength = 1024 * 1024;
+
+}  // namespace
+
 AdsTabHelper::AdsTabHelper(content::WebContents* web_contents)
     : WebContentsObserver(web_contents),
       tab_id_(sessions::SessionTabHelper::IdForTab(web_contents)),
@@ -73,39 +81,33 @@ void AdsTabHelper::TabUpdated() {
                              is_browser_active_);
 }
 
-void AdsTabHelper::RunIsolatedJavaScript(
+void AdsTabHelper::ExtractPageContent(
     content::RenderFrameHost* render_frame_host) {
   DCHECK(render_frame_host);
 
-  dom_distiller::RunIsolatedJavaScript(
-      render_frame_host, "new XMLSerializer().serializeToString(document)",
-      base::BindOnce(&AdsTabHelper::OnJavaScriptHtmlResult,
-                     weak_factory_.GetWeakPtr()));
+  // Rebind for each document as the remote is bound to the render frame which
+  // committed the navigation
+  page_content_extractor_.reset();
+  render_frame_host->GetRemoteAssociatedInterfaces()->GetInterface(
+      &page_content_extractor_);
 
-  dom_distiller::RunIsolatedJavaScript(
-      render_frame_host, "document.body.innerText",
-      base::BindOnce(&AdsTabHelper::OnJavaScriptTextResult,
+  page_content_extractor_->ExtractPageContent(
+      kMaximumPageTextLength,
+      base::BindOnce(&AdsTabHelper::OnPageContentExtracted,
                      weak_factory_.GetWeakPtr()));
 }
 
-void AdsTabHelper::OnJavaScriptHtmlResult(base::Value value) {
-  DCHECK(ads_service_ && ads_service_->IsEnabled());
-
-  DCHECK(value.is_string());
-  std::string html;
-  value.GetAsString(&html);
-
-  ads_service_->OnHtmlLoaded(tab_id_, redirect_chain_, html);
-}
-
-void AdsTabHelper::OnJavaScriptTextResult(base::Value value) {
-  DCHECK(ads_service_ && ads_service_->IsEnabled());
-
-  DCHECK(value.is_string());
-  std::string text;
-  value.GetAsString(&text);
+void AdsTabHelper::OnPageContentExtracted(
+    base::ReadOnlySharedMemoryRegion html_region,
+    base::ReadOnlySharedMemoryRegion text_region) {
+  if (!IsAdsEnabled()) {
+    return;
+  }
 
-  ads_service_->OnTextLoaded(tab_id_, redirect_chain_, text);
+  // The regions are passed on to bat ads without being mapped here, so page
+  // content is not copied on the UI thread
+  ads_service_->OnHtmlLoaded(tab_id_, redirect_chain_, std::move(html_region));
+  ads_service_->OnTextLoaded(tab_id_, redirect_chain_, std::move(text_region));
 }
 
 void AdsTabHelper::DidFinishNavigation(
@@ -135,7 +137,7 @@ void AdsTabHelper::DidFinishNavigation(
   content::RenderFrameHost* render_frame_host =
       navigation_handle->GetRenderFrameHost();
 
-  RunIsolatedJavaScript(render_frame_host);
+  ExtractPageContent(render_frame_host);
 }
 
 void AdsTabHelper::DocumentOnLoadCompletedInMainFrame(
@@ -144,11 +146,7 @@ void AdsTabHelper::DocumentOnLoadCompletedInMainFrame(
     return;
   }
 
-  std::unique_ptr<dom_distiller::SourcePageHandleWebContents> handle =
-      std::make_unique<dom_distiller::SourcePageHandleWebContents>(
-          web_contents(), false);
-
-  RunIsolatedJavaScript(render_frame_host);
+  ExtractPageContent(render_frame_host);
 }
 
 void AdsTabHelper::DidFinishLoad(content::RenderFrameHost* render_frame_host,
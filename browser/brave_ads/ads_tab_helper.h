@@ -12,12 +12,15 @@
 #include <vector>
 
 #include "base/macros.h"
+#include "base/memory/read_only_shared_memory_region.h"
 #include "base/memory/weak_ptr.h"
+#include "brave/components/brave_ads/common/page_content_extractor.mojom.h"
 #include "build/build_config.h"
 #include "components/sessions/core/session_id.h"
 #include "content/public/browser/media_player_id.h"
 #include "content/public/browser/web_contents_observer.h"
 #include "content/public/browser/web_contents_user_data.h"
+#include "mojo/public/cpp/bindings/associated_remote.h"
 #include "url/gurl.h"
 
 #if !defined(OS_ANDROID)
@@ -26,16 +29,6 @@
 
 class Browser;
 
-namespace dom_distiller {
-
-class DistillerPage;
-
-namespace proto {
-class DomDistillerResult;
-}  // namespace proto
-
-}  // namespace dom_distiller
-
 namespace brave_ads {
 
 class AdsService;
@@ -59,11 +52,10 @@ class AdsTabHelper : public content::WebContentsObserver,
 
   void TabUpdated();
 
-  void RunIsolatedJavaScript(content::RenderFrameHost* render_frame_host);
-
-  void OnJavaScriptHtmlResult(base::Value value);
+  void ExtractPageContent(content::RenderFrameHost* render_frame_host);
 
-  void OnJavaScriptTextResult(base::Value value);
+  void OnPageContentExtracted(base::ReadOnlySharedMemoryRegion html_region,
+                              base::ReadOnlySharedMemoryRegion text_region);
 
   // content::WebContentsObserver overrides
   void DidFinishNavigation(
@@ -94,6 +86,8 @@ class AdsTabHelper : public content::WebContentsObserver,
   std::vector<GURL> redirect_chain_;
   bool should_process_;
 
+  mojo::AssociatedRemote<mojom::PageContentExtractor> page_content_extractor_;
+
   base::WeakPtrFactory<AdsTabHelper> weak_factory_;
   WEB_CONTENTS_USER_DATA_KEY_DECL();
 };
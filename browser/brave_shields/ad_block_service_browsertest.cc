@@ -1123,6 +1123,44 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, CosmeticFilteringGenerichide) {
                    "'display', 'inline')"));
 }
 
+// Test that a `generichide` exception rule matching only some URLs of a host
+// is still applied after resources for that host have been cached
+IN_PROC_BROWSER_TEST_F(AdBlockServiceTest,
+                       CosmeticFilteringGenerichideForSomeURLsOfHost) {
+  UpdateAdBlockInstanceWithRules(
+      "##.blockme\n"
+      "@@||b.com/cosmetic_filtering.html?generichide$generichide");
+
+  WaitForBraveExtensionShieldsDataReady();
+
+  GURL tab_url =
+      embedded_test_server()->GetURL("b.com", "/cosmetic_filtering.html");
+  ui_test_utils::NavigateToURL(browser(), tab_url);
+
+  content::WebContents* contents =
+      browser()->tab_strip_model()->GetActiveWebContents();
+
+  auto result = EvalJsWithManualReply(contents,
+                                      R"(function waitCSSSelector() {
+          if (checkSelector('.blockme', 'display', 'none')) {
+            window.domAutomationController.send(true);
+          } else {
+            console.log('still waiting for css selector');
+            setTimeout(waitCSSSelector, 200);
+          }
+        } waitCSSSelector())");
+  ASSERT_TRUE(result.error.empty());
+  EXPECT_EQ(base::Value(true), result.value);
+
+  tab_url = embedded_test_server()->GetURL(
+      "b.com", "/cosmetic_filtering.html?generichide");
+  ui_test_utils::NavigateToURL(browser(), tab_url);
+
+  ASSERT_EQ(true, EvalJs(contents,
+                         "addElementsDynamically();\n"
+                         "checkSelector('.blockme', 'display', 'inline')"));
+}
+
 // Test custom style rules
 IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, CosmeticFilteringCustomStyle) {
   UpdateAdBlockInstanceWithRules("b.com##.ad:style(padding-bottom: 10px)");
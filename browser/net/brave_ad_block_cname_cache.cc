@@ -0,0 +1,89 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/net/brave_ad_block_cname_cache.h"
+
+#include <memory>
+
+#include "content/public/browser/browser_context.h"
+#include "content/public/browser/browser_thread.h"
+
+namespace brave {
+
+namespace {
+
+const char kBraveAdBlockCnameCacheKey[] = "brave_ad_block_cname_cache";
+
+}  // namespace
+
+const size_t BraveAdBlockCnameCache::kMaxSize = 1000;
+
+const base::TimeDelta BraveAdBlockCnameCache::kTimeToLive =
+    base::TimeDelta::FromMinutes(1);
+
+BraveAdBlockCnameCache::BraveAdBlockCnameCache(size_t max_size)
+    : entries_(max_size) {}
+
+BraveAdBlockCnameCache::~BraveAdBlockCnameCache() = default;
+
+// static
+BraveAdBlockCnameCache* BraveAdBlockCnameCache::FromBrowserContext(
+    content::BrowserContext* browser_context) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  DCHECK(browser_context);
+
+  BraveAdBlockCnameCache* cache = static_cast<BraveAdBlockCnameCache*>(
+      browser_context->GetUserData(kBraveAdBlockCnameCacheKey));
+  if (!cache) {
+    // Object cleanup is handled by SupportsUserData
+    auto new_cache = std::make_unique<BraveAdBlockCnameCache>();
+    cache = new_cache.get();
+    browser_context->SetUserData(kBraveAdBlockCnameCacheKey,
+                                 std::move(new_cache));
+  }
+  return cache;
+}
+
+bool BraveAdBlockCnameCache::Get(
+    const net::NetworkIsolationKey& network_isolation_key,
+    const std::string& host,
+    const base::TimeTicks now,
+    std::string* canonical_name) {
+  DCHECK(canonical_name);
+
+  auto iter = entries_.Get(std::make_pair(network_isolation_key, host));
+  if (iter == entries_.end()) {
+    return false;
+  }
+
+  if (now >= iter->second.expire_at) {
+    entries_.Erase(iter);
+    return false;
+  }
+
+  *canonical_name = iter->second.canonical_name;
+  return true;
+}
+
+void BraveAdBlockCnameCache::Put(
+    const net::NetworkIsolationKey& network_isolation_key,
+    const std::string& host,
+    const std::string& canonical_name,
+    const base::TimeTicks now) {
+  Entry entry;
+  entry.canonical_name = canonical_name;
+  entry.expire_at = now + kTimeToLive;
+  entries_.Put(std::make_pair(network_isolation_key, host), std::move(entry));
+}
+
+void BraveAdBlockCnameCache::Clear() {
+  entries_.Clear();
+}
+
+size_t BraveAdBlockCnameCache::size() const {
+  return entries_.size();
+}
+
+}  // namespace brave
@@ -0,0 +1,75 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_BROWSER_NET_BRAVE_AD_BLOCK_CNAME_CACHE_H_
+#define BRAVE_BROWSER_NET_BRAVE_AD_BLOCK_CNAME_CACHE_H_
+
+#include <string>
+#include <utility>
+
+#include "base/containers/mru_cache.h"
+#include "base/memory/weak_ptr.h"
+#include "base/supports_user_data.h"
+#include "base/time/time.h"
+#include "net/base/network_isolation_key.h"
+
+namespace content {
+class BrowserContext;
+}  // namespace content
+
+namespace brave {
+
+// Caches the canonical names resolved for CNAME uncloaking, keyed by network
+// isolation key and host, so that repeated subresource requests to the same
+// host do not wait for another DNS round trip before adblocking. Each browser
+// context owns its own cache, so that resolutions made in an off-the-record
+// profile are never visible to other profiles, and vice versa.
+class BraveAdBlockCnameCache
+    : public base::SupportsUserData::Data,
+      public base::SupportsWeakPtr<BraveAdBlockCnameCache> {
+ public:
+  static const size_t kMaxSize;
+  static const base::TimeDelta kTimeToLive;
+
+  explicit BraveAdBlockCnameCache(size_t max_size = kMaxSize);
+  ~BraveAdBlockCnameCache() override;
+
+  // Returns the cache used for network requests made by |browser_context|,
+  // creating it if needed. Must be called on the UI thread.
+  static BraveAdBlockCnameCache* FromBrowserContext(
+      content::BrowserContext* browser_context);
+
+  // Returns true and sets |canonical_name| if there is an entry for |host|
+  // which has not expired at |now|
+  bool Get(const net::NetworkIsolationKey& network_isolation_key,
+           const std::string& host,
+           const base::TimeTicks now,
+           std::string* canonical_name);
+
+  void Put(const net::NetworkIsolationKey& network_isolation_key,
+           const std::string& host,
+           const std::string& canonical_name,
+           const base::TimeTicks now);
+
+  void Clear();
+
+  size_t size() const;
+
+ private:
+  using Key = std::pair<net::NetworkIsolationKey, std::string>;
+
+  struct Entry {
+    std::string canonical_name;
+    base::TimeTicks expire_at;
+  };
+
+  base::MRUCache<Key, Entry> entries_;
+
+  DISALLOW_COPY_AND_ASSIGN(BraveAdBlockCnameCache);
+};
+
+}  // namespace brave
+
+#endif  // BRAVE_BROWSER_NET_BRAVE_AD_BLOCK_CNAME_CACHE_H_
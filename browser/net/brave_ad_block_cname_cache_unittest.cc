@@ -0,0 +1,112 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/net/brave_ad_block_cname_cache.h"
+
+#include <string>
+
+#include "chrome/browser/profiles/profile.h"
+#include "chrome/test/base/testing_profile.h"
+#include "content/public/test/browser_task_environment.h"
+#include "net/base/network_isolation_key.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+#include "url/origin.h"
+
+namespace brave {
+
+namespace {
+
+net::NetworkIsolationKey CreateNetworkIsolationKey(const std::string& url) {
+  const url::Origin origin = url::Origin::Create(GURL(url));
+  return net::NetworkIsolationKey(origin, origin);
+}
+
+}  // namespace
+
+TEST(BraveAdBlockCnameCacheTest, Miss) {
+  BraveAdBlockCnameCache cache;
+  std::string canonical_name;
+  EXPECT_FALSE(cache.Get(CreateNetworkIsolationKey("https://a.com"), "b.com",
+                         base::TimeTicks::Now(), &canonical_name));
+}
+
+TEST(BraveAdBlockCnameCacheTest, HitWithinTimeToLive) {
+  BraveAdBlockCnameCache cache;
+  const net::NetworkIsolationKey key =
+      CreateNetworkIsolationKey("https://a.com");
+  const base::TimeTicks now = base::TimeTicks::Now();
+  cache.Put(key, "b.com", "tracker.com", now);
+
+  std::string canonical_name;
+  EXPECT_TRUE(cache.Get(key, "b.com",
+                        now + BraveAdBlockCnameCache::kTimeToLive / 2,
+                        &canonical_name));
+  EXPECT_EQ("tracker.com", canonical_name);
+}
+
+TEST(BraveAdBlockCnameCacheTest, ExpiredEntry) {
+  BraveAdBlockCnameCache cache;
+  const net::NetworkIsolationKey key =
+      CreateNetworkIsolationKey("https://a.com");
+  const base::TimeTicks now = base::TimeTicks::Now();
+  cache.Put(key, "b.com", "tracker.com", now);
+
+  std::string canonical_name;
+  EXPECT_FALSE(cache.Get(key, "b.com",
+                         now + BraveAdBlockCnameCache::kTimeToLive,
+                         &canonical_name));
+  EXPECT_EQ(0UL, cache.size());
+}
+
+TEST(BraveAdBlockCnameCacheTest, IsolatedByNetworkIsolationKey) {
+  BraveAdBlockCnameCache cache;
+  const base::TimeTicks now = base::TimeTicks::Now();
+  cache.Put(CreateNetworkIsolationKey("https://a.com"), "b.com", "tracker.com",
+            now);
+
+  std::string canonical_name;
+  EXPECT_FALSE(cache.Get(CreateNetworkIsolationKey("https://c.com"), "b.com",
+                         now, &canonical_name));
+}
+
+TEST(BraveAdBlockCnameCacheTest, EvictsLeastRecentlyUsed) {
+  BraveAdBlockCnameCache cache(2);
+  const net::NetworkIsolationKey key =
+      CreateNetworkIsolationKey("https://a.com");
+  const base::TimeTicks now = base::TimeTicks::Now();
+  cache.Put(key, "b.com", "b.tracker.com", now);
+  cache.Put(key, "c.com", "c.tracker.com", now);
+  cache.Put(key, "d.com", "d.tracker.com", now);
+
+  std::string canonical_name;
+  EXPECT_FALSE(cache.Get(key, "b.com", now, &canonical_name));
+  EXPECT_TRUE(cache.Get(key, "d.com", now, &canonical_name));
+  EXPECT_EQ("d.tracker.com", canonical_name);
+}
+
+TEST(BraveAdBlockCnameCacheTest, IsolatedByBrowserContext) {
+  content::BrowserTaskEnvironment task_environment;
+  TestingProfile profile;
+  Profile* otr_profile = profile.GetPrimaryOTRProfile();
+
+  BraveAdBlockCnameCache* cache =
+      BraveAdBlockCnameCache::FromBrowserContext(&profile);
+  BraveAdBlockCnameCache* otr_cache =
+      BraveAdBlockCnameCache::FromBrowserContext(otr_profile);
+  ASSERT_NE(cache, otr_cache);
+  EXPECT_EQ(cache, BraveAdBlockCnameCache::FromBrowserContext(&profile));
+
+  const net::NetworkIsolationKey key =
+      CreateNetworkIsolationKey("https://a.com");
+  const base::TimeTicks now = base::TimeTicks::Now();
+  otr_cache->Put(key, "b.com", "tracker.com", now);
+
+  std::string canonical_name;
+  EXPECT_FALSE(cache->Get(key, "b.com", now, &canonical_name));
+  EXPECT_TRUE(otr_cache->Get(key, "b.com", now, &canonical_name));
+}
+
+}  // namespace brave
@@ -12,9 +12,12 @@
 
 #include "base/base64url.h"
 #include "base/feature_list.h"
+#include "base/memory/ref_counted.h"
+#include "base/metrics/histogram_macros.h"
 #include "base/strings/string_util.h"
 #include "brave/browser/brave_browser_process.h"
 #include "brave/browser/brave_shields/brave_shields_web_contents_observer.h"
+#include "brave/browser/net/brave_ad_block_cname_cache.h"
 #include "brave/browser/net/url_context.h"
 #include "brave/common/network_constants.h"
 #include "brave/common/url_constants.h"
@@ -46,38 +49,68 @@ void SetAdblockCnameHostResolverForTesting(
   g_testing_host_resolver = host_resolver;
 }
 
-void ShouldBlockAdOnTaskRunner(std::shared_ptr<BraveRequestInfo> ctx,
-                               base::Optional<std::string> canonical_name) {
+struct AdBlockMatchResult {
   bool did_match_rule = false;
   bool did_match_exception = false;
   bool did_match_important = false;
-  if (!ctx->initiator_url.is_valid()) {
-    return;
+  std::string mock_data_url;
+
+  bool ShouldBlock() const {
+    return did_match_important || (did_match_rule && !did_match_exception);
   }
-  std::string source_host = ctx->initiator_url.host();
+};
 
+// Matches |url| against the adblock engines, accumulating into the flags of
+// |result| so that the canonical name can be checked after the original URL.
+AdBlockMatchResult ShouldBlockUrlOnTaskRunner(const GURL& url,
+                                              const std::string& source_host,
+                                              blink::mojom::ResourceType type,
+                                              AdBlockMatchResult result) {
   g_brave_browser_process->ad_block_service()->ShouldStartRequest(
-      ctx->request_url, ctx->resource_type, source_host, &did_match_rule,
-      &did_match_exception, &did_match_important, &ctx->mock_data_url);
-  if (did_match_important) {
-    ctx->blocked_by = kAdBlocked;
-    return;
+      url, type, source_host, &result.did_match_rule,
+      &result.did_match_exception, &result.did_match_important,
+      &result.mock_data_url);
+  return result;
+}
+
+base::Optional<GURL> GetCanonicalURL(
+    const GURL& request_url,
+    const base::Optional<std::string>& canonical_name) {
+  if (!canonical_name.has_value() || *canonical_name == "" ||
+      request_url.host() == *canonical_name) {
+    return base::nullopt;
   }
 
-  if (canonical_name.has_value() &&
-      ctx->request_url.host() != *canonical_name && *canonical_name != "") {
-    GURL::Replacements replacements = GURL::Replacements();
-    replacements.SetHost(
-        canonical_name->c_str(),
-        url::Component(0, static_cast<int>(canonical_name->length())));
-    const GURL canonical_url = ctx->request_url.ReplaceComponents(replacements);
+  GURL::Replacements replacements = GURL::Replacements();
+  replacements.SetHost(
+      canonical_name->c_str(),
+      url::Component(0, static_cast<int>(canonical_name->length())));
+  return request_url.ReplaceComponents(replacements);
+}
 
-    g_brave_browser_process->ad_block_service()->ShouldStartRequest(
-        canonical_url, ctx->resource_type, source_host, &did_match_rule,
-        &did_match_exception, &did_match_important, &ctx->mock_data_url);
+void ShouldBlockAdOnTaskRunner(std::shared_ptr<BraveRequestInfo> ctx,
+                               base::Optional<std::string> canonical_name) {
+  if (!ctx->initiator_url.is_valid()) {
+    return;
+  }
+  const std::string source_host = ctx->initiator_url.host();
+
+  AdBlockMatchResult result;
+  result.mock_data_url = ctx->mock_data_url;
+  result = ShouldBlockUrlOnTaskRunner(ctx->request_url, source_host,
+                                      ctx->resource_type, result);
+
+  if (!result.did_match_important) {
+    const base::Optional<GURL> canonical_url =
+        GetCanonicalURL(ctx->request_url, canonical_name);
+    if (canonical_url) {
+      result = ShouldBlockUrlOnTaskRunner(*canonical_url, source_host,
+                                          ctx->resource_type, result);
+    }
   }
 
-  if (did_match_important || (did_match_rule && !did_match_exception)) {
+  ctx->mock_data_url = result.mock_data_url;
+  if (result.ShouldBlock()) {
     ctx->blocked_by = kAdBlocked;
   }
 }
@@ -103,22 +136,138 @@ void ShouldBlockAdWithOptionalCname(
       base::BindOnce(&OnShouldBlockAdResult, next_callback, ctx));
 }
 
+// Checks the original URL against the adblock engines while the canonical name
+// is being resolved, and only waits for DNS if the first pass did not already
+// decide to block the request.
+class AdBlockCnamePipeline : public base::RefCounted<AdBlockCnamePipeline> {
+ public:
+  AdBlockCnamePipeline(scoped_refptr<base::SequencedTaskRunner> task_runner,
+                       const ResponseCallback& next_callback,
+                       std::shared_ptr<BraveRequestInfo> ctx)
+      : task_runner_(task_runner), next_callback_(next_callback), ctx_(ctx) {
+    DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  }
+
+  void Start() {
+    DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+    if (!ctx_->initiator_url.is_valid()) {
+      first_pass_result_ = AdBlockMatchResult();
+      first_pass_time_ = base::TimeTicks::Now();
+      return;
+    }
+
+    AdBlockMatchResult result;
+    result.mock_data_url = ctx_->mock_data_url;
+    task_runner_->PostTaskAndReplyWithResult(
+        FROM_HERE,
+        base::BindOnce(&ShouldBlockUrlOnTaskRunner, ctx_->request_url,
+                       ctx_->initiator_url.host(), ctx_->resource_type,
+                       result),
+        base::BindOnce(&AdBlockCnamePipeline::OnFirstPassComplete, this));
+  }
+
+  void OnCanonicalNameResolved(base::Optional<std::string> canonical_name) {
+    DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+    canonical_name_ = canonical_name;
+    did_resolve_ = true;
+
+    if (is_complete_ || !first_pass_result_) {
+      return;
+    }
+
+    UMA_HISTOGRAM_TIMES("Brave.ShieldsCNAMEBlocking.AddedLatency",
+                        base::TimeTicks::Now() - first_pass_time_);
+    RunSecondPass();
+  }
+
+ private:
+  friend class base::RefCounted<AdBlockCnamePipeline>;
+
+  ~AdBlockCnamePipeline() = default;
+
+  void OnFirstPassComplete(AdBlockMatchResult result) {
+    DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+    first_pass_result_ = result;
+    first_pass_time_ = base::TimeTicks::Now();
+
+    if (result.did_match_important) {
+      Complete(result);
+      return;
+    }
+
+    if (!did_resolve_) {
+      return;
+    }
+
+    UMA_HISTOGRAM_TIMES("Brave.ShieldsCNAMEBlocking.AddedLatency",
+                        base::TimeDelta());
+    RunSecondPass();
+  }
+
+  void RunSecondPass() {
+    DCHECK(first_pass_result_);
+    const base::Optional<GURL> canonical_url =
+        GetCanonicalURL(ctx_->request_url, canonical_name_);
+    if (!canonical_url || !ctx_->initiator_url.is_valid()) {
+      Complete(*first_pass_result_);
+      return;
+    }
+
+    task_runner_->PostTaskAndReplyWithResult(
+        FROM_HERE,
+        base::BindOnce(&ShouldBlockUrlOnTaskRunner, *canonical_url,
+                       ctx_->initiator_url.host(), ctx_->resource_type,
+                       *first_pass_result_),
+        base::BindOnce(&AdBlockCnamePipeline::Complete, this));
+  }
+
+  void Complete(AdBlockMatchResult result) {
+    DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+    DCHECK(!is_complete_);
+    is_complete_ = true;
+
+    if (ctx_->initiator_url.is_valid()) {
+      ctx_->mock_data_url = result.mock_data_url;
+      if (result.ShouldBlock()) {
+        ctx_->blocked_by = kAdBlocked;
+      }
+    }
+
+    OnShouldBlockAdResult(next_callback_, ctx_);
+  }
+
+  scoped_refptr<base::SequencedTaskRunner> task_runner_;
+  ResponseCallback next_callback_;
+  std::shared_ptr<BraveRequestInfo> ctx_;
+
+  base::Optional<AdBlockMatchResult> first_pass_result_;
+  base::TimeTicks first_pass_time_;
+  base::Optional<std::string> canonical_name_;
+  bool did_resolve_ = false;
+  bool is_complete_ = false;
+
+  DISALLOW_COPY_AND_ASSIGN(AdBlockCnamePipeline);
+};
+
 class AdblockCnameResolveHostClient : public network::mojom::ResolveHostClient {
  private:
   mojo::Receiver<network::mojom::ResolveHostClient> receiver_{this};
   base::OnceCallback<void(base::Optional<std::string>)> cb_;
+  net::NetworkIsolationKey network_isolation_key_;
+  std::string host_;
+  base::WeakPtr<BraveAdBlockCnameCache> cname_cache_;
   base::TimeTicks start_time_;
 
  public:
   AdblockCnameResolveHostClient(
-      const ResponseCallback& next_callback,
-      scoped_refptr<base::SequencedTaskRunner> task_runner,
-      std::shared_ptr<BraveRequestInfo> ctx) {
-    cb_ = base::BindOnce(&ShouldBlockAdWithOptionalCname, task_runner,
-                         std::move(next_callback), ctx);
-
-    const auto network_isolation_key = ctx->network_isolation_key;
-
+      std::shared_ptr<BraveRequestInfo> ctx,
+      base::OnceCallback<void(base::Optional<std::string>)> cb)
+      : cb_(std::move(cb)),
+        network_isolation_key_(ctx->network_isolation_key),
+        host_(ctx->request_url.host()),
+        cname_cache_(
+            BraveAdBlockCnameCache::FromBrowserContext(ctx->browser_context)
+                ->AsWeakPtr()) {
     network::mojom::ResolveHostParametersPtr optional_parameters =
         network::mojom::ResolveHostParameters::New();
     optional_parameters->include_canonical_name = true;
@@ -141,11 +290,11 @@ class AdblockCnameResolveHostClient : public network::mojom::ResolveHostClient {
 
     if (g_testing_host_resolver) {
       g_testing_host_resolver->ResolveHost(
-          net::HostPortPair::FromURL(ctx->request_url), network_isolation_key,
+          net::HostPortPair::FromURL(ctx->request_url), network_isolation_key_,
           std::move(optional_parameters), receiver_.BindNewPipeAndPassRemote());
     } else {
       network_context->ResolveHost(
-          net::HostPortPair::FromURL(ctx->request_url), network_isolation_key,
+          net::HostPortPair::FromURL(ctx->request_url), network_isolation_key_,
           std::move(optional_parameters), receiver_.BindNewPipeAndPassRemote());
     }
 
@@ -163,8 +312,13 @@ class AdblockCnameResolveHostClient : public network::mojom::ResolveHostClient {
                         base::TimeTicks::Now() - start_time_);
     if (result == net::OK && resolved_addresses) {
       DCHECK(resolved_addresses.has_value() && !resolved_addresses->empty());
-      std::move(cb_).Run(
-          base::Optional<std::string>(resolved_addresses->GetCanonicalName()));
+      const std::string canonical_name =
+          resolved_addresses->GetCanonicalName();
+      if (cname_cache_) {
+        cname_cache_->Put(network_isolation_key_, host_, canonical_name,
+                          base::TimeTicks::Now());
+      }
+      std::move(cb_).Run(base::Optional<std::string>(canonical_name));
     } else {
       std::move(cb_).Run(base::nullopt);
     }
@@ -199,10 +353,27 @@ void OnBeforeURLRequestAdBlockTP(const ResponseCallback& next_callback,
   if (ctx->browser_context->IsTor()) {
     ShouldBlockAdWithOptionalCname(task_runner, std::move(next_callback), ctx,
                                    base::nullopt);
-  } else {
-    new AdblockCnameResolveHostClient(std::move(next_callback), task_runner,
-                                      ctx);
+    return;
   }
+
+  std::string canonical_name;
+  const bool is_cached =
+      BraveAdBlockCnameCache::FromBrowserContext(ctx->browser_context)
+          ->Get(ctx->network_isolation_key, ctx->request_url.host(),
+                base::TimeTicks::Now(), &canonical_name);
+  UMA_HISTOGRAM_BOOLEAN("Brave.ShieldsCNAMEBlocking.CacheHit", is_cached);
+  if (is_cached) {
+    ShouldBlockAdWithOptionalCname(task_runner, std::move(next_callback), ctx,
+                                   canonical_name);
+    return;
+  }
+
+  auto pipeline = base::MakeRefCounted<AdBlockCnamePipeline>(
+      task_runner, std::move(next_callback), ctx);
+  pipeline->Start();
+  new AdblockCnameResolveHostClient(
+      ctx,
+      base::BindOnce(&AdBlockCnamePipeline::OnCanonicalNameResolved, pipeline));
 }
 
 int OnBeforeURLRequest_AdBlockTPPreWork(const ResponseCallback& next_callback,
@@ -64,7 +64,9 @@ class BraveRequestHandler {
   // rewards service. Eliminating this will also help to avoid using
   // PrefChangeRegistrar and corresponding |base::Unretained| usages, that are
   // illegal.
-  std::unique_ptr<base::ListValue> referral_headers_list_;
+  // Immutable snapshot which is shared with in-flight requests, so that a pref
+  // change never invalidates the list while a request is using it.
+  std::shared_ptr<const base::ListValue> referral_headers_list_;
   std::map<uint64_t, net::CompletionOnceCallback> callbacks_;
   std::unique_ptr<PrefChangeRegistrar, content::BrowserThread::DeleteOnUIThread>
       pref_change_registrar_;
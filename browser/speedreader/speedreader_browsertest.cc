@@ -3,8 +3,13 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include <string>
+
 #include "base/bind.h"
+#include "base/files/file_util.h"
 #include "base/path_service.h"
+#include "base/test/metrics/histogram_tester.h"
+#include "base/threading/thread_restrictions.h"
 #include "brave/app/brave_command_ids.h"
 #include "brave/common/brave_paths.h"
 #include "brave/components/speedreader/features.h"
@@ -17,6 +22,7 @@
 #include "content/public/test/browser_test.h"
 #include "content/public/test/browser_test_utils.h"
 #include "net/dns/mock_host_resolver.h"
+#include "net/test/embedded_test_server/controllable_http_response.h"
 #include "net/test/embedded_test_server/embedded_test_server.h"
 
 const char kTestHost[] = "theguardian.com";
@@ -30,6 +36,17 @@ constexpr char kSpeedreaderToggleUMAHistogramName[] =
 constexpr char kSpeedreaderEnabledUMAHistogramName[] =
     "Brave.SpeedReader.Enabled";
 
+constexpr char kSpeedreaderDistillUMAHistogramName[] =
+    "Brave.Speedreader.Distill";
+
+constexpr char kGetStyleCount[] =
+    "document.querySelectorAll(\"#brave_speedreader_style\").length";
+
+constexpr char kResponseHeaders[] =
+    "HTTP/1.1 200 OK\r\n"
+    "Content-Type: text/html; charset=utf-8\r\n"
+    "\r\n";
+
 class SpeedReaderBrowserTest : public InProcessBrowserTest {
  public:
   SpeedReaderBrowserTest()
@@ -63,6 +80,40 @@ class SpeedReaderBrowserTest : public InProcessBrowserTest {
     host_resolver()->AddRule("*", "127.0.0.1");
   }
 
+  std::string ReadTestPage() {
+    base::ScopedAllowBlockingForTesting allow_blocking;
+    base::FilePath test_data_dir;
+    base::PathService::Get(brave::DIR_TEST_DATA, &test_data_dir);
+    std::string page;
+    base::ReadFileToString(test_data_dir.AppendASCII("guardian.html"), &page);
+    return page;
+  }
+
+  content::WebContents* web_contents() {
+    return browser()->tab_strip_model()->GetActiveWebContents();
+  }
+
+  // Starts a navigation to |path| on |server| and serves |body| in |chunks|
+  // pieces, so that the loader receives the body in separate reads.
+  void NavigateAndServeInChunks(net::EmbeddedTestServer* server,
+                                net::test_server::ControllableHttpResponse*
+                                    response,
+                                const std::string& path,
+                                const std::string& body,
+                                size_t chunks) {
+    ui_test_utils::NavigateToURLWithDisposition(
+        browser(), server->GetURL(kTestHost, path),
+        WindowOpenDisposition::CURRENT_TAB,
+        ui_test_utils::BROWSER_TEST_NONE);
+    response->WaitForRequest();
+    response->Send(kResponseHeaders);
+    const size_t chunk_size = body.size() / chunks + 1;
+    for (size_t offset = 0; offset < body.size(); offset += chunk_size)
+      response->Send(body.substr(offset, chunk_size));
+    response->Done();
+    EXPECT_TRUE(content::WaitForLoadStop(web_contents()));
+  }
+
  protected:
   base::test::ScopedFeatureList feature_list_;
   net::EmbeddedTestServer https_server_;
@@ -110,3 +161,70 @@ IN_PROC_BROWSER_TEST_F(SpeedReaderBrowserTest, P3ATest) {
   tester.ExpectBucketCount(kSpeedreaderToggleUMAHistogramName, 1, 1);
   tester.ExpectBucketCount(kSpeedreaderToggleUMAHistogramName, 2, 0);
 }
+
+IN_PROC_BROWSER_TEST_F(SpeedReaderBrowserTest, DistillBodyReadInChunks) {
+  base::HistogramTester tester;
+  net::EmbeddedTestServer server(net::EmbeddedTestServer::TYPE_HTTPS);
+  net::test_server::ControllableHttpResponse response(&server, kTestPage);
+  ASSERT_TRUE(server.Start());
+
+  std::string page = ReadTestPage();
+  ASSERT_FALSE(page.empty());
+
+  chrome::ExecuteCommand(browser(), IDC_TOGGLE_SPEEDREADER);
+  NavigateAndServeInChunks(&server, &response, kTestPage, page, 8);
+
+  // The page is distilled once, and only the distilled output is sent.
+  tester.ExpectTotalCount(kSpeedreaderDistillUMAHistogramName, 1);
+  content::RenderFrameHost* rfh = web_contents()->GetMainFrame();
+  EXPECT_EQ(1, content::EvalJs(rfh, kGetStyleCount));
+  EXPECT_GT(static_cast<int>(page.size()) / 2,
+            content::EvalJs(rfh, "document.body.innerHTML.length"));
+}
+
+IN_PROC_BROWSER_TEST_F(SpeedReaderBrowserTest,
+                       FallbackToOriginalBodyWithoutReadableContent) {
+  net::EmbeddedTestServer server(net::EmbeddedTestServer::TYPE_HTTPS);
+  net::test_server::ControllableHttpResponse response(&server, "/empty.html");
+  ASSERT_TRUE(server.Start());
+
+  const std::string page =
+      "<html><body><p id=\"first\">first</p>" + std::string(4096, ' ') +
+      "<p id=\"last\">last</p></body></html>";
+
+  chrome::ExecuteCommand(browser(), IDC_TOGGLE_SPEEDREADER);
+  NavigateAndServeInChunks(&server, &response, "/empty.html", page, 4);
+
+  // Nothing has been distilled, so the whole original page is loaded.
+  content::RenderFrameHost* rfh = web_contents()->GetMainFrame();
+  EXPECT_EQ(0, content::EvalJs(rfh, kGetStyleCount));
+  EXPECT_EQ("first",
+            content::EvalJs(rfh, "document.getElementById(\"first\").id"));
+  EXPECT_EQ("last",
+            content::EvalJs(rfh, "document.getElementById(\"last\").id"));
+}
+
+IN_PROC_BROWSER_TEST_F(SpeedReaderBrowserTest,
+                       FallbackToOriginalBodyWhenDistillingIsGivenUp) {
+  net::EmbeddedTestServer server(net::EmbeddedTestServer::TYPE_HTTPS);
+  net::test_server::ControllableHttpResponse response(&server, kTestPage);
+  ASSERT_TRUE(server.Start());
+
+  std::string page = ReadTestPage();
+  ASSERT_FALSE(page.empty());
+  // Pad the readable page past the size which is kept for fallback, so that
+  // distilling is given up after part of the body has been distilled.
+  const size_t end_of_body = page.rfind("</body>");
+  ASSERT_NE(std::string::npos, end_of_body);
+  page.insert(end_of_body, std::string(9 * 1024 * 1024, ' ') +
+                               "<p id=\"last\">last</p>");
+
+  chrome::ExecuteCommand(browser(), IDC_TOGGLE_SPEEDREADER);
+  NavigateAndServeInChunks(&server, &response, kTestPage, page, 16);
+
+  // The original page is loaded up to its very end rather than truncated.
+  content::RenderFrameHost* rfh = web_contents()->GetMainFrame();
+  EXPECT_EQ(0, content::EvalJs(rfh, kGetStyleCount));
+  EXPECT_EQ("last",
+            content::EvalJs(rfh, "document.getElementById(\"last\").id"));
+}
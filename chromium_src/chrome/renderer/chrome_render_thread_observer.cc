@@ -0,0 +1,18 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "chrome/renderer/chrome_render_thread_observer.h"
+
+#define SetContentSettingRules SetContentSettingRules_ChromiumImpl
+#include "../../../../chrome/renderer/chrome_render_thread_observer.cc"
+#undef SetContentSettingRules
+
+// Frames and workers look up the rules stored here, so index them once per
+// update rather than on lookup.
+void ChromeRenderThreadObserver::SetContentSettingRules(
+    const RendererContentSettingRules& rules) {
+  SetContentSettingRules_ChromiumImpl(rules);
+  content_settings::BuildRulesIndexes(&content_setting_rules_);
+}
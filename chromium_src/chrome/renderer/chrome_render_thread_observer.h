@@ -0,0 +1,20 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_CHROMIUM_SRC_CHROME_RENDERER_CHROME_RENDER_THREAD_OBSERVER_H_
+#define BRAVE_CHROMIUM_SRC_CHROME_RENDERER_CHROME_RENDER_THREAD_OBSERVER_H_
+
+#include "chrome/common/renderer_configuration.mojom.h"
+
+#define SetContentSettingRules                   \
+  SetContentSettingRules_ChromiumImpl(           \
+      const RendererContentSettingRules& rules); \
+  void SetContentSettingRules
+
+#include "../../../../chrome/renderer/chrome_render_thread_observer.h"
+
+#undef SetContentSettingRules
+
+#endif  // BRAVE_CHROMIUM_SRC_CHROME_RENDERER_CHROME_RENDER_THREAD_OBSERVER_H_
@@ -10,15 +10,18 @@
 
 BraveFarblingLevel WorkerContentSettingsClient::GetBraveFarblingLevel() {
   ContentSetting setting = CONTENT_SETTING_DEFAULT;
+  // |content_setting_rules_| is a copy of the rules stored by the render
+  // thread, which carries the indexes built when they were stored
   if (content_setting_rules_) {
     const GURL& primary_url = top_frame_origin_.GetURL();
     const GURL& secondary_url = document_origin_.GetURL();
-    for (const auto& rule : content_setting_rules_->brave_shields_rules) {
-      if (rule.primary_pattern.Matches(primary_url) &&
-          rule.secondary_pattern.Matches(secondary_url)) {
-        setting = rule.GetContentSetting();
-        break;
-      }
+    const ContentSettingPatternSource* rule =
+        content_settings::FindMatchingRule(
+            content_setting_rules_->brave_shields_rules,
+            content_setting_rules_->brave_shields_rules_index, primary_url,
+            secondary_url);
+    if (rule) {
+      setting = rule->GetContentSetting();
     }
     if (setting == CONTENT_SETTING_BLOCK) {
       // Brave Shields is down
@@ -26,7 +29,8 @@ BraveFarblingLevel WorkerContentSettingsClient::GetBraveFarblingLevel() {
     } else {
       // Brave Shields is up, so check fingerprinting rules
       setting = GetBraveFPContentSettingFromRules(
-          content_setting_rules_->fingerprinting_rules, primary_url);
+          content_setting_rules_->fingerprinting_rules,
+          content_setting_rules_->fingerprinting_rules_index, primary_url);
     }
   }
   if (setting == CONTENT_SETTING_BLOCK) {
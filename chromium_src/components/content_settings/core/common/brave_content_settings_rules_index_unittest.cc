@@ -0,0 +1,170 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <string>
+
+#include "base/stl_util.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/values.h"
+#include "brave/components/brave_shields/common/brave_shield_utils.h"
+#include "components/content_settings/core/common/content_settings.h"
+#include "components/content_settings/core/common/content_settings_pattern.h"
+#include "components/content_settings/core/common/content_settings_utils.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace content_settings {
+
+namespace {
+
+ContentSettingPatternSource CreateRule(const std::string& primary_pattern,
+                                       const std::string& secondary_pattern,
+                                       ContentSetting setting) {
+  return ContentSettingPatternSource(
+      ContentSettingsPattern::FromString(primary_pattern),
+      ContentSettingsPattern::FromString(secondary_pattern),
+      base::Value::FromUniquePtrValue(ContentSettingToValue(setting)),
+      std::string(), false);
+}
+
+const ContentSettingPatternSource* FindMatchingRuleLinearly(
+    const ContentSettingsForOneType& rules,
+    const GURL& primary_url,
+    const GURL& secondary_url) {
+  for (const auto& rule : rules) {
+    if (rule.primary_pattern.Matches(primary_url) &&
+        rule.secondary_pattern.Matches(secondary_url)) {
+      return &rule;
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+TEST(BraveContentSettingsRulesIndexTest, FindsRulesInPrecedenceOrder) {
+  ContentSettingsForOneType rules;
+  rules.push_back(
+      CreateRule("https://a.example.com", "*", CONTENT_SETTING_BLOCK));
+  rules.push_back(CreateRule("[*.]example.com", "*", CONTENT_SETTING_ALLOW));
+  rules.push_back(CreateRule("*", "*", CONTENT_SETTING_BLOCK));
+  const RulesIndex index = BuildRulesIndex(rules);
+  const GURL secondary_url("https://cdn.example.net/script.js");
+
+  EXPECT_EQ(&rules[0], FindMatchingRule(rules, index,
+                                        GURL("https://a.example.com/"),
+                                        secondary_url));
+  EXPECT_EQ(&rules[1], FindMatchingRule(rules, index,
+                                        GURL("http://a.example.com/"),
+                                        secondary_url));
+  EXPECT_EQ(&rules[1], FindMatchingRule(rules, index,
+                                        GURL("https://b.a.example.com/"),
+                                        secondary_url));
+  EXPECT_EQ(&rules[1], FindMatchingRule(rules, index,
+                                        GURL("https://example.com/"),
+                                        secondary_url));
+  EXPECT_EQ(&rules[2], FindMatchingRule(rules, index,
+                                        GURL("https://example.org/"),
+                                        secondary_url));
+}
+
+TEST(BraveContentSettingsRulesIndexTest, PrefersEarlierWildcardRule) {
+  ContentSettingsForOneType rules;
+  rules.push_back(
+      CreateRule("*", "https://cdn.example.net", CONTENT_SETTING_ALLOW));
+  rules.push_back(CreateRule("[*.]example.com", "*", CONTENT_SETTING_BLOCK));
+  const RulesIndex index = BuildRulesIndex(rules);
+
+  EXPECT_EQ(&rules[0],
+            FindMatchingRule(rules, index, GURL("https://example.com/"),
+                             GURL("https://cdn.example.net/script.js")));
+  EXPECT_EQ(&rules[1],
+            FindMatchingRule(rules, index, GURL("https://example.com/"),
+                             GURL("https://example.com/script.js")));
+  EXPECT_EQ(nullptr,
+            FindMatchingRule(rules, index, GURL("https://example.org/"),
+                             GURL("https://example.org/script.js")));
+}
+
+TEST(BraveContentSettingsRulesIndexTest, FindsRulesInCopiedRules) {
+  RendererContentSettingRules rules;
+  rules.brave_shields_rules.push_back(
+      CreateRule("[*.]example.com", "*", CONTENT_SETTING_BLOCK));
+  rules.autoplay_rules.push_back(
+      CreateRule("https://example.org", "*", CONTENT_SETTING_BLOCK));
+  rules.fingerprinting_rules.push_back(
+      CreateRule("*", "*", CONTENT_SETTING_ALLOW));
+  BuildRulesIndexes(&rules);
+
+  // Copies of the rules carry an index which is valid for the copy
+  const RendererContentSettingRules copied_rules = rules;
+  rules = RendererContentSettingRules();
+
+  EXPECT_EQ(&copied_rules.brave_shields_rules[0],
+            FindMatchingRule(copied_rules.brave_shields_rules,
+                             copied_rules.brave_shields_rules_index,
+                             GURL("https://www.example.com/"),
+                             GURL("https://example.com/script.js")));
+  EXPECT_EQ(&copied_rules.autoplay_rules[0],
+            FindMatchingRule(copied_rules.autoplay_rules,
+                             copied_rules.autoplay_rules_index,
+                             GURL("https://example.org/"),
+                             GURL("https://example.org/")));
+  EXPECT_EQ(CONTENT_SETTING_ALLOW,
+            GetBraveFPContentSettingFromRules(
+                copied_rules.fingerprinting_rules,
+                copied_rules.fingerprinting_rules_index,
+                GURL("https://example.net/")));
+}
+
+TEST(BraveContentSettingsRulesIndexTest, MatchesLinearSearchForManyRules) {
+  ContentSettingsForOneType rules;
+  for (int i = 0; i < 1000; ++i) {
+    const std::string site = "site" + base::NumberToString(i) + ".com";
+    const ContentSetting setting =
+        i % 2 ? CONTENT_SETTING_ALLOW : CONTENT_SETTING_BLOCK;
+    if (i % 3 == 0) {
+      rules.push_back(CreateRule("https://" + site, "*", setting));
+    } else {
+      rules.push_back(CreateRule("[*.]" + site, "*", setting));
+    }
+  }
+  rules.push_back(CreateRule("*", "*", CONTENT_SETTING_ALLOW));
+  const RulesIndex index = BuildRulesIndex(rules);
+
+  for (int i = 0; i < 300; ++i) {
+    const GURL primary_url("https://www.site" + base::NumberToString(i * 7) +
+                           ".com/");
+    const GURL secondary_url("https://cdn" + base::NumberToString(i) +
+                             ".example.net/script.js");
+    EXPECT_EQ(FindMatchingRuleLinearly(rules, primary_url, secondary_url),
+              FindMatchingRule(rules, index, primary_url, secondary_url));
+  }
+}
+
+TEST(BraveContentSettingsRulesIndexTest, FindsFingerprintingSetting) {
+  ContentSettingsForOneType rules;
+  rules.push_back(CreateRule("[*.]example.com", "https://firstParty",
+                             CONTENT_SETTING_BLOCK));
+  rules.push_back(
+      CreateRule("[*.]example.com", "https://balanced", CONTENT_SETTING_BLOCK));
+  rules.push_back(CreateRule("[*.]example.org", "*", CONTENT_SETTING_ALLOW));
+  rules.push_back(CreateRule("*", "*", CONTENT_SETTING_BLOCK));
+  const RulesIndex index = BuildRulesIndex(rules);
+
+  const GURL urls[] = {GURL("https://www.example.com/"),
+                       GURL("https://example.org/"),
+                       GURL("https://example.net/")};
+  const ContentSetting expected_settings[] = {
+      CONTENT_SETTING_DEFAULT, CONTENT_SETTING_ALLOW, CONTENT_SETTING_BLOCK};
+  for (size_t i = 0; i < base::size(urls); ++i) {
+    EXPECT_EQ(expected_settings[i],
+              GetBraveFPContentSettingFromRules(rules, urls[i]));
+    EXPECT_EQ(expected_settings[i],
+              GetBraveFPContentSettingFromRules(rules, index, urls[i]));
+  }
+}
+
+}  // namespace content_settings
@@ -3,6 +3,10 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include "base/bind.h"
+#include "components/content_settings/core/common/content_settings_pattern.h"
+#include "url/gurl.h"
+
 // Leave a gap between Chromium values and our values in the kHistogramValue
 // array so that we don't have to renumber when new content settings types are
 // added upstream.
@@ -48,3 +52,127 @@ int ContentSettingTypeToHistogramValue(ContentSettingsType content_setting,
   return ContentSettingTypeToHistogramValue_ChromiumImpl(content_setting,
                                                          num_values);
 }
+
+namespace content_settings {
+
+namespace {
+
+bool SecondaryPatternMatches(const GURL& secondary_url,
+                             const ContentSettingPatternSource& rule) {
+  return rule.secondary_pattern.Matches(secondary_url);
+}
+
+// Returns the position of the first rule in |positions| before |end| which
+// matches, or |end| if none match.
+size_t FindFirstMatchingRule(const ContentSettingsForOneType& rules,
+                             const std::vector<size_t>& positions,
+                             const GURL& primary_url,
+                             const RuleFilter& filter,
+                             size_t end) {
+  for (const size_t position : positions) {
+    if (position >= end) {
+      break;
+    }
+
+    const ContentSettingPatternSource& rule = rules[position];
+    if (rule.primary_pattern.Matches(primary_url) && filter.Run(rule)) {
+      return position;
+    }
+  }
+
+  return end;
+}
+
+}  // namespace
+
+RulesIndex::RulesIndex() = default;
+
+RulesIndex::RulesIndex(const RulesIndex& other) = default;
+
+RulesIndex& RulesIndex::operator=(const RulesIndex& other) = default;
+
+RulesIndex::~RulesIndex() = default;
+
+RulesIndex BuildRulesIndex(const ContentSettingsForOneType& rules) {
+  RulesIndex index;
+  for (size_t i = 0; i < rules.size(); ++i) {
+    const ContentSettingsPattern& pattern = rules[i].primary_pattern;
+    const std::string& host = pattern.GetHost();
+    if (host.empty()) {
+      index.wildcard_rules.push_back(i);
+    } else if (pattern.HasDomainWildcard()) {
+      index.domain_rules[host].push_back(i);
+    } else {
+      index.host_rules[host].push_back(i);
+    }
+  }
+
+  return index;
+}
+
+void BuildRulesIndexes(RendererContentSettingRules* rules) {
+  rules->autoplay_rules_index = BuildRulesIndex(rules->autoplay_rules);
+  rules->fingerprinting_rules_index =
+      BuildRulesIndex(rules->fingerprinting_rules);
+  rules->brave_shields_rules_index =
+      BuildRulesIndex(rules->brave_shields_rules);
+}
+
+const ContentSettingPatternSource* FindMatchingRule(
+    const ContentSettingsForOneType& rules,
+    const RulesIndex& index,
+    const GURL& primary_url,
+    const GURL& secondary_url) {
+  return FindMatchingRule(
+      rules, index, primary_url,
+      base::BindRepeating(&SecondaryPatternMatches, secondary_url));
+}
+
+const ContentSettingPatternSource* FindMatchingRule(
+    const ContentSettingsForOneType& rules,
+    const RulesIndex& index,
+    const GURL& primary_url,
+    const RuleFilter& filter) {
+  // Rules are checked in precedence order within each bucket, so only rules
+  // with a higher precedence than the best match so far need to be checked in
+  // the remaining buckets
+  size_t match = FindFirstMatchingRule(rules, index.wildcard_rules,
+                                       primary_url, filter, rules.size());
+
+  std::string host = primary_url.host();
+  if (!host.empty() && host.back() == '.') {
+    host.pop_back();
+  }
+
+  if (!host.empty()) {
+    const auto host_iter = index.host_rules.find(host);
+    if (host_iter != index.host_rules.end()) {
+      match = FindFirstMatchingRule(rules, host_iter->second, primary_url,
+                                    filter, match);
+    }
+
+    // Check the host and each of its parent domains
+    size_t pos = 0;
+    while (true) {
+      const auto domain_iter = index.domain_rules.find(host.substr(pos));
+      if (domain_iter != index.domain_rules.end()) {
+        match = FindFirstMatchingRule(rules, domain_iter->second, primary_url,
+                                      filter, match);
+      }
+
+      pos = host.find('.', pos);
+      if (pos == std::string::npos) {
+        break;
+      }
+      ++pos;
+    }
+  }
+
+  if (match == rules.size()) {
+    return nullptr;
+  }
+
+  return &rules[match];
+}
+
+}  // namespace content_settings
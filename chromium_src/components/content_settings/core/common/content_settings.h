@@ -6,13 +6,80 @@
 #ifndef BRAVE_CHROMIUM_SRC_COMPONENTS_CONTENT_SETTINGS_CORE_COMMON_CONTENT_SETTINGS_H_
 #define BRAVE_CHROMIUM_SRC_COMPONENTS_CONTENT_SETTINGS_CORE_COMMON_CONTENT_SETTINGS_H_
 
-#define BRAVE_CONTENT_SETTINGS_H                  \
-  ContentSettingsForOneType autoplay_rules;       \
-  ContentSettingsForOneType fingerprinting_rules; \
-  ContentSettingsForOneType brave_shields_rules;
+#include <map>
+#include <string>
+#include <vector>
+
+#include "base/callback_forward.h"
+
+class GURL;
+struct ContentSettingPatternSource;
+
+namespace content_settings {
+
+// Positions of the rules of one content settings type, bucketed by the host of
+// their primary pattern, so that matching a URL only checks the rules that can
+// match its host. Positions are kept in ascending order, which is the
+// precedence order of the indexed rules. Positions stay valid for copies of the
+// rules, so copying the rules along with their index keeps the index current.
+struct RulesIndex {
+  RulesIndex();
+  RulesIndex(const RulesIndex& other);
+  RulesIndex& operator=(const RulesIndex& other);
+  ~RulesIndex();
+
+  // Patterns matching exactly one host, e.g. https://www.brave.com
+  std::map<std::string, std::vector<size_t>> host_rules;
+  // Patterns matching a domain and its subdomains, e.g. [*.]brave.com
+  std::map<std::string, std::vector<size_t>> domain_rules;
+  // Patterns without a host, e.g. * or file:///
+  std::vector<size_t> wildcard_rules;
+};
+
+}  // namespace content_settings
+
+// The indexes are built by BuildRulesIndexes() whenever the rules are stored
+#define BRAVE_CONTENT_SETTINGS_H                           \
+  ContentSettingsForOneType autoplay_rules;                \
+  ContentSettingsForOneType fingerprinting_rules;          \
+  ContentSettingsForOneType brave_shields_rules;           \
+  content_settings::RulesIndex autoplay_rules_index;       \
+  content_settings::RulesIndex fingerprinting_rules_index; \
+  content_settings::RulesIndex brave_shields_rules_index;
 
 #include "../../../../../../components/content_settings/core/common/content_settings.h"
 
 #undef BRAVE_CONTENT_SETTINGS_H
 
+namespace content_settings {
+
+using RuleFilter =
+    base::RepeatingCallback<bool(const ContentSettingPatternSource& rule)>;
+
+// Builds the index of |rules|, which must be sorted by precedence.
+RulesIndex BuildRulesIndex(const ContentSettingsForOneType& rules);
+
+// Builds the indexes of the Brave rules of |rules|. Must be called again after
+// the rules are modified.
+void BuildRulesIndexes(RendererContentSettingRules* rules);
+
+// Returns the highest precedence rule of |rules| matching |primary_url| and
+// |secondary_url| or nullptr if none match. |index| must have been built for
+// |rules|.
+const ContentSettingPatternSource* FindMatchingRule(
+    const ContentSettingsForOneType& rules,
+    const RulesIndex& index,
+    const GURL& primary_url,
+    const GURL& secondary_url);
+
+// Returns the highest precedence rule of |rules| matching |primary_url| for
+// which |filter| returns true or nullptr if none match.
+const ContentSettingPatternSource* FindMatchingRule(
+    const ContentSettingsForOneType& rules,
+    RulesIndex* index,
+    const GURL& primary_url,
+    const RuleFilter& filter);
+
+}  // namespace content_settings
+
 #endif  // BRAVE_CHROMIUM_SRC_COMPONENTS_CONTENT_SETTINGS_CORE_COMMON_CONTENT_SETTINGS_H_
@@ -6,6 +6,8 @@
 #include "third_party/blink/renderer/core/execution_context/execution_context.h"
 
 #include "base/command_line.h"
+#include "base/containers/span.h"
+#include "base/hash/legacy_hash.h"
 #include "base/strings/string_number_conversions.h"
 #include "brave/third_party/blink/renderer/brave_farbling_constants.h"
 #include "crypto/hmac.h"
@@ -31,25 +33,10 @@ inline uint64_t lfsr_next(uint64_t v) {
   return ((v >> 1) | (((v << 62) ^ (v << 61)) & (~(~zero << 63) << 62)));
 }
 
-float Identity(float value, size_t index) {
-  return value;
-}
-
-float ConstantMultiplier(double fudge_factor, float value, size_t index) {
-  return value * fudge_factor;
-}
+const double maxUInt64AsDouble = UINT64_MAX;
 
-float PseudoRandomSequence(uint64_t seed, float value, size_t index) {
-  static uint64_t v;
-  const double maxUInt64AsDouble = UINT64_MAX;
-  if (index == 0) {
-    // start of loop, reset to initial seed which was passed in and is based on
-    // the domain key
-    v = seed;
-  }
-  // get next value in PRNG sequence
-  v = lfsr_next(v);
-  // return pseudo-random float between 0 and 0.1
+// Returns a pseudo-random float between 0 and 0.1
+inline float PseudoRandomSample(uint64_t v) {
   return (v / maxUInt64AsDouble) / 10;
 }
 
@@ -85,6 +72,47 @@ blink::WebContentSettingsClient* GetContentSettingsClientFor(
   return settings;
 }
 
+AudioFarblingHelper::AudioFarblingHelper(double fudge_factor,
+                                         uint64_t seed,
+                                         bool max)
+    : fudge_factor_(fudge_factor),
+      seed_(seed),
+      max_(max),
+      sample_state_(seed) {}
+
+void AudioFarblingHelper::FarbleAudioChannel(float* dst, size_t count) const {
+  if (max_) {
+    // The sequence is inherently serial, but keeping its state in a local
+    // lets the compiler keep it in a register.
+    uint64_t v = seed_;
+    for (size_t i = 0; i < count; i++) {
+      v = lfsr_next(v);
+      dst[i] = PseudoRandomSample(v);
+    }
+    return;
+  }
+
+  // Simple enough for the compiler to vectorize.
+  const double fudge_factor = fudge_factor_;
+  for (size_t i = 0; i < count; i++) {
+    dst[i] = dst[i] * fudge_factor;
+  }
+}
+
+float AudioFarblingHelper::FarbleAudioSample(float value, size_t index) {
+  if (!max_)
+    return value * fudge_factor_;
+
+  if (index == 0) {
+    // start of loop, reset to initial seed which was passed in and is based on
+    // the domain key
+    sample_state_ = seed_;
+  }
+  // get next value in PRNG sequence
+  sample_state_ = lfsr_next(sample_state_);
+  return PseudoRandomSample(sample_state_);
+}
+
 BraveSessionCache::BraveSessionCache(ExecutionContext& context)
     : Supplement<ExecutionContext>(context) {
   farbling_enabled_ = false;
@@ -130,7 +158,7 @@ BraveSessionCache& BraveSessionCache::From(ExecutionContext& context) {
   return *cache;
 }
 
-AudioFarblingCallback BraveSessionCache::GetAudioFarblingCallback(
+base::Optional<AudioFarblingHelper> BraveSessionCache::GetAudioFarblingHelper(
     blink::WebContentSettingsClient* settings) {
   if (farbling_enabled_ && settings) {
     switch (settings->GetBraveFarblingLevel()) {
@@ -139,19 +167,30 @@ AudioFarblingCallback BraveSessionCache::GetAudioFarblingCallback(
       }
       case BraveFarblingLevel::BALANCED: {
         const uint64_t* fudge = reinterpret_cast<const uint64_t*>(domain_key_);
-        const double maxUInt64AsDouble = UINT64_MAX;
         double fudge_factor = 0.99 + ((*fudge / maxUInt64AsDouble) / 100);
         VLOG(1) << "audio fudge factor (based on session token) = "
                 << fudge_factor;
-        return base::BindRepeating(&ConstantMultiplier, fudge_factor);
+        return AudioFarblingHelper(fudge_factor, 0, false);
       }
       case BraveFarblingLevel::MAXIMUM: {
         uint64_t seed = *reinterpret_cast<uint64_t*>(domain_key_);
-        return base::BindRepeating(&PseudoRandomSequence, seed);
+        return AudioFarblingHelper(1, seed, true);
       }
     }
   }
-  return base::BindRepeating(&Identity);
+  return base::nullopt;
+}
+
+void BraveSessionCache::FarbleAudioChannel(
+    blink::WebContentSettingsClient* settings,
+    float* dst,
+    size_t count) {
+  if (!dst || count == 0)
+    return;
+  if (base::Optional<AudioFarblingHelper> helper =
+          GetAudioFarblingHelper(settings)) {
+    helper->FarbleAudioChannel(dst, count);
+  }
 }
 
 void BraveSessionCache::PerturbPixels(blink::WebContentSettingsClient* settings,
@@ -179,21 +218,28 @@ void BraveSessionCache::PerturbPixelsInternal(const unsigned char* data,
     return;
 
   uint8_t* pixels = const_cast<uint8_t*>(data);
-  // This needs to be type size_t because we pass it to base::StringPiece
+  // This needs to be type size_t because we pass it to base::make_span
   // later for content hashing. This is safe because the maximum canvas
   // dimensions are less than SIZE_T_MAX. (Width and height are each
   // limited to 32,767 pixels.)
   // Four bits per pixel
   const size_t pixel_count = size / 4;
   // calculate initial seed to find first pixel to perturb, based on session
-  // key, domain key, and canvas contents
+  // key, domain key, and canvas contents. Canvases can be read back every
+  // frame, so the contents are reduced to a fast non-cryptographic digest
+  // first and only the digest is signed with the session and domain key.
+  // CityHash64 is used rather than base::FastHash because the latter is only
+  // as wide as size_t, which would leave a 32-bit digest on 32-bit platforms.
+  const uint64_t canvas_digest =
+      base::legacy::CityHash64(base::make_span(pixels, size));
   crypto::HMAC h(crypto::HMAC::SHA256);
   uint64_t session_plus_domain_key =
       session_key_ ^ *reinterpret_cast<uint64_t*>(domain_key_);
   CHECK(h.Init(reinterpret_cast<const unsigned char*>(&session_plus_domain_key),
                sizeof session_plus_domain_key));
   uint8_t canvas_key[32];
-  CHECK(h.Sign(base::StringPiece(reinterpret_cast<const char*>(pixels), size),
+  CHECK(h.Sign(base::StringPiece(reinterpret_cast<const char*>(&canvas_digest),
+                                 sizeof canvas_digest),
                canvas_key, sizeof canvas_key));
   uint64_t v = *reinterpret_cast<uint64_t*>(canvas_key);
   uint64_t pixel_index;
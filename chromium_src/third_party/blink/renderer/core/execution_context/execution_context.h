@@ -10,7 +10,7 @@
 
 #include <random>
 
-#include "base/callback.h"
+#include "base/optional.h"
 
 namespace blink {
 class WebContentSettingsClient;
@@ -26,7 +26,26 @@ using blink::TraceTrait;
 
 namespace brave {
 
-typedef base::RepeatingCallback<float(float, size_t)> AudioFarblingCallback;
+// Farbles audio samples. BALANCED scales every sample by a per-domain factor
+// and MAXIMUM replaces samples with a per-domain pseudo-random sequence.
+class CORE_EXPORT AudioFarblingHelper {
+ public:
+  AudioFarblingHelper(double fudge_factor, uint64_t seed, bool max);
+
+  // Farbles |count| samples of |dst| in place. The pseudo-random sequence is
+  // local to the call, so this is safe to call from any thread.
+  void FarbleAudioChannel(float* dst, size_t count) const;
+
+  // Farbles the sample at |index| of a buffer which is iterated in order. The
+  // pseudo-random sequence restarts at index 0.
+  float FarbleAudioSample(float value, size_t index);
+
+ private:
+  double fudge_factor_;
+  uint64_t seed_;
+  bool max_;
+  uint64_t sample_state_;
+};
 
 CORE_EXPORT blink::WebContentSettingsClient* GetContentSettingsClientFor(
     ExecutionContext* context);
@@ -42,8 +61,12 @@ class CORE_EXPORT BraveSessionCache final
 
   static BraveSessionCache& From(ExecutionContext&);
 
-  AudioFarblingCallback GetAudioFarblingCallback(
+  // Returns base::nullopt if audio should not be farbled.
+  base::Optional<AudioFarblingHelper> GetAudioFarblingHelper(
       blink::WebContentSettingsClient* settings);
+  void FarbleAudioChannel(blink::WebContentSettingsClient* settings,
+                          float* dst,
+                          size_t count);
   void PerturbPixels(blink::WebContentSettingsClient* settings,
                      const unsigned char* data,
                      size_t size);
@@ -109,6 +109,16 @@ void c_char_buffer_destroy(char *s);
  */
 char *engine_url_cosmetic_resources(struct C_Engine *engine, const char *url);
 
+/**
+ * Returns whether generic cosmetic filtering is disabled for the given url by a `$generichide`
+ * exception.
+ *
+ * Unlike the rest of the url cosmetic resources, this can depend on the full url rather than
+ * just its hostname. Only the flag is returned, so the hostname specific selectors are not
+ * serialized again.
+ */
+bool engine_url_generic_hide(struct C_Engine *engine, const char *url);
+
 /**
  * Returns a stylesheet containing all generic cosmetic rules that begin with any of the provided class and id selectors
  *
@@ -242,6 +242,20 @@ pub unsafe extern "C" fn engine_url_cosmetic_resources(
     ptr
 }
 
+/// Returns whether generic cosmetic filtering is disabled for the given url by a `$generichide`
+/// exception.
+///
+/// Unlike the rest of the url cosmetic resources, this can depend on the full url rather than
+/// just its hostname. Only the flag is returned, so the hostname specific selectors are not
+/// serialized again.
+#[no_mangle]
+pub unsafe extern "C" fn engine_url_generic_hide(engine: *mut Engine, url: *const c_char) -> bool {
+    let url = CStr::from_ptr(url).to_str().unwrap();
+    assert!(!engine.is_null());
+    let engine = Box::leak(Box::from_raw(engine));
+    engine.url_cosmetic_resources(url).generichide
+}
+
 /// Returns a stylesheet containing all generic cosmetic rules that begin with any of the provided class and id selectors
 ///
 /// The leading '.' or '#' character should not be provided
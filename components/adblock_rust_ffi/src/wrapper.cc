@@ -113,6 +113,10 @@ const std::string Engine::urlCosmeticResources(const std::string& url) {
   return resources_json;
 }
 
+bool Engine::urlGenericHide(const std::string& url) {
+  return engine_url_generic_hide(raw, url.c_str());
+}
+
 const std::string Engine::hiddenClassIdSelectors(
     const std::vector<std::string>& classes,
     const std::vector<std::string>& ids,
@@ -11,6 +11,7 @@
 #include <vector>
 
 #include "base/callback_forward.h"
+#include "base/memory/read_only_shared_memory_region.h"
 #include "base/macros.h"
 #include "base/observer_list.h"
 #include "brave/components/brave_ads/browser/ads_service_observer.h"
@@ -94,13 +95,15 @@ class AdsService : public KeyedService {
 
   virtual void ChangeLocale(const std::string& locale) = 0;
 
+  // Page content is passed as read-only shared memory, which is only mapped
+  // by bat ads
   virtual void OnHtmlLoaded(const SessionID& tab_id,
                             const std::vector<GURL>& redirect_chain,
-                            const std::string& html) = 0;
+                            base::ReadOnlySharedMemoryRegion html) = 0;
 
   virtual void OnTextLoaded(const SessionID& tab_id,
                             const std::vector<GURL>& redirect_chain,
-                            const std::string& text) = 0;
+                            base::ReadOnlySharedMemoryRegion text) = 0;
 
   virtual void OnUserGesture(const int32_t page_transition_type) = 0;
 
@@ -23,6 +23,7 @@
 #include "base/logging.h"
 #include "base/memory/ptr_util.h"
 #include "base/metrics/field_trial_params.h"
+#include "base/metrics/histogram_macros.h"
 #include "base/numerics/ranges.h"
 #include "base/path_service.h"
 #include "base/sequenced_task_runner.h"
@@ -32,6 +33,7 @@
 #include "base/task/thread_pool.h"
 #include "base/task_runner_util.h"
 #include "base/time/time.h"
+#include "base/values.h"
 #include "bat/ads/ad_history_info.h"
 #include "bat/ads/ad_notification_info.h"
 #include "bat/ads/ads.h"
@@ -60,6 +62,7 @@
 #include "brave/components/rpill/common/rpill.h"
 #include "brave/components/services/bat_ads/public/cpp/ads_client_mojo_bridge.h"
 #include "brave/components/services/bat_ads/public/interfaces/bat_ads.mojom.h"
+#include "brave/components/weekly_storage/weekly_storage_registry_factory.h"
 #include "brave/grit/brave_generated_resources.h"
 #include "build/build_config.h"
 #include "chrome/browser/browser_process.h"
@@ -114,6 +117,34 @@ namespace {
 
 constexpr char kAdNotificationUrlPrefix[] = "https://www.brave.com/ads/?";
 
+// Prefs which are mirrored into bat ads so that they can be read without a
+// synchronous IPC
+const char* const kMirroredPrefs[] = {
+    ads::prefs::kEnabled,
+    ads::prefs::kShouldAllowConversionTracking,
+    ads::prefs::kAdsPerHour,
+    ads::prefs::kIdleTimeThreshold,
+    ads::prefs::kShouldAllowAdsSubdivisionTargeting,
+    ads::prefs::kAdsSubdivisionTargetingCode,
+    ads::prefs::kAutoDetectedAdsSubdivisionTargetingCode,
+    ads::prefs::kCatalogId,
+    ads::prefs::kCatalogVersion,
+    ads::prefs::kCatalogPing,
+    ads::prefs::kCatalogLastUpdated,
+    ads::prefs::kEpsilonGreedyBanditArms,
+    ads::prefs::kEpsilonGreedyBanditEligibleSegments,
+    ads::prefs::kHasMigratedConversionState};
+
+bool IsMirroredPref(const std::string& path) {
+  for (const char* mirrored_pref : kMirroredPrefs) {
+    if (path == mirrored_pref) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
 static std::map<std::string, int> g_schema_resource_ids = {
     {ads::g_catalog_schema_resource_id, IDR_ADS_CATALOG_SCHEMA}};
 
@@ -313,7 +344,7 @@ void AdsServiceImpl::ChangeLocale(const std::string& locale) {
 
 void AdsServiceImpl::OnHtmlLoaded(const SessionID& tab_id,
                                   const std::vector<GURL>& redirect_chain,
-                                  const std::string& html) {
+                                  base::ReadOnlySharedMemoryRegion html) {
   if (!connected()) {
     return;
   }
@@ -323,12 +354,13 @@ void AdsServiceImpl::OnHtmlLoaded(const SessionID& tab_id,
     redirect_chain_as_strings.push_back(url.spec());
   }
 
-  bat_ads_->OnHtmlLoaded(tab_id.id(), redirect_chain_as_strings, html);
+  bat_ads_->OnHtmlLoaded(tab_id.id(), redirect_chain_as_strings,
+                         std::move(html));
 }
 
 void AdsServiceImpl::OnTextLoaded(const SessionID& tab_id,
                                   const std::vector<GURL>& redirect_chain,
-                                  const std::string& text) {
+                                  base::ReadOnlySharedMemoryRegion text) {
   if (!connected()) {
     return;
   }
@@ -338,7 +370,8 @@ void AdsServiceImpl::OnTextLoaded(const SessionID& tab_id,
     redirect_chain_as_strings.push_back(url.spec());
   }
 
-  bat_ads_->OnTextLoaded(tab_id.id(), redirect_chain_as_strings, text);
+  bat_ads_->OnTextLoaded(tab_id.id(), redirect_chain_as_strings,
+                         std::move(text));
 }
 
 void AdsServiceImpl::OnUserGesture(const int32_t page_transition_type) {
@@ -557,12 +590,16 @@ void AdsServiceImpl::Shutdown() {
 
   BackgroundHelper::GetInstance()->RemoveObserver(this);
 
+  FrequencyCappingHelper::GetInstance()->RemoveObserver(this);
+
   g_brave_browser_process->resource_component()->RemoveObserver(this);
 
   url_loaders_.clear();
 
   idle_poll_timer_.Stop();
 
+  state_bytes_written_timer_.Stop();
+
   bat_ads_.reset();
   bat_ads_client_receiver_.reset();
   bat_ads_service_.reset();
@@ -572,6 +609,16 @@ void AdsServiceImpl::Shutdown() {
   VLOG_IF(1, !success) << "Failed to release database";
 }
 
+void AdsServiceImpl::SetBatAdsForTesting(
+    mojo::PendingAssociatedRemote<bat_ads::mojom::BatAds> bat_ads) {
+  bat_ads_.Bind(std::move(bat_ads));
+
+  FrequencyCappingHelper::GetInstance()->AddObserver(this);
+
+  SetBatAdsPrefs();
+  SetBatAdsAdEvents();
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 bool MigrateConfirmationsStateOnFileTaskRunner(const base::FilePath& path) {
@@ -641,13 +688,11 @@ void AdsServiceImpl::OnMigrateConfirmationsState(const bool success) {
 void AdsServiceImpl::Initialize() {
   profile_pref_change_registrar_.Init(profile_->GetPrefs());
 
-  profile_pref_change_registrar_.Add(
-      ads::prefs::kEnabled,
-      base::Bind(&AdsServiceImpl::OnPrefsChanged, base::Unretained(this)));
-
-  profile_pref_change_registrar_.Add(
-      ads::prefs::kIdleTimeThreshold,
-      base::Bind(&AdsServiceImpl::OnPrefsChanged, base::Unretained(this)));
+  for (const char* mirrored_pref : kMirroredPrefs) {
+    profile_pref_change_registrar_.Add(
+        mirrored_pref,
+        base::Bind(&AdsServiceImpl::OnPrefsChanged, base::Unretained(this)));
+  }
 
   profile_pref_change_registrar_.Add(
       brave_rewards::prefs::kWalletBrave,
@@ -678,6 +723,10 @@ void AdsServiceImpl::OnInitialize(const int32_t result) {
   MaybeOpenNewTabWithAd();
 
   StartCheckIdleStateTimer();
+
+  state_bytes_written_timer_.Start(
+      FROM_HERE, base::TimeDelta::FromHours(1), this,
+      &AdsServiceImpl::RecordStateBytesWritten);
 }
 
 void AdsServiceImpl::ShutdownBatAds() {
@@ -845,6 +894,8 @@ void AdsServiceImpl::OnEnsureBaseDirectoryExists(const bool success) {
 
   BackgroundHelper::GetInstance()->AddObserver(this);
 
+  FrequencyCappingHelper::GetInstance()->AddObserver(this);
+
   database_ = std::make_unique<ads::Database>(
       base_path_.AppendASCII("database.sqlite"));
 
@@ -853,6 +904,9 @@ void AdsServiceImpl::OnEnsureBaseDirectoryExists(const bool success) {
       bat_ads_.BindNewEndpointAndPassReceiver(),
       base::BindOnce(&AdsServiceImpl::OnCreate, AsWeakPtr()));
 
+  SetBatAdsPrefs();
+  SetBatAdsAdEvents();
+
   OnWalletUpdated();
 
   const std::string locale = GetLocale();
@@ -921,6 +975,12 @@ void AdsServiceImpl::StartCheckIdleStateTimer() {
 #endif
 }
 
+void AdsServiceImpl::RecordStateBytesWritten() {
+  UMA_HISTOGRAM_MEMORY_KB("Brave.Ads.StateBytesWrittenPerHour",
+                          state_bytes_written_ / 1024);
+  state_bytes_written_ = 0;
+}
+
 void AdsServiceImpl::CheckIdleState() {
   const int idle_threshold = GetIdleTimeThreshold();
   const ui::IdleState idle_state = ui::CalculateIdleState(idle_threshold);
@@ -1673,7 +1733,57 @@ bool AdsServiceImpl::PrefExists(const std::string& path) const {
   return profile_->GetPrefs()->HasPrefPath(path);
 }
 
+void AdsServiceImpl::SetBatAdsPrefs() {
+  if (!connected()) {
+    return;
+  }
+
+  base::flat_map<std::string, base::Value> prefs;
+
+  for (const char* mirrored_pref : kMirroredPrefs) {
+    const PrefService::Preference* pref =
+        profile_->GetPrefs()->FindPreference(mirrored_pref);
+    if (!pref) {
+      continue;
+    }
+
+    prefs[mirrored_pref] = pref->GetValue()->Clone();
+  }
+
+  bat_ads_->SetPrefs(std::move(prefs));
+}
+
+void AdsServiceImpl::NotifyBatAdsPrefChanged(const std::string& path) {
+  if (!connected()) {
+    return;
+  }
+
+  const PrefService::Preference* pref =
+      profile_->GetPrefs()->FindPreference(path);
+  if (!pref) {
+    return;
+  }
+
+  bat_ads_->OnPrefChanged(path, pref->GetValue()->Clone());
+}
+
+void AdsServiceImpl::SetBatAdsAdEvents() {
+  if (!connected()) {
+    return;
+  }
+
+  const ads::AdEventHistory::History& ad_events =
+      FrequencyCappingHelper::GetInstance()->GetAllAdEvents();
+
+  bat_ads_->SetAdEvents(base::flat_map<std::string, std::vector<uint64_t>>(
+      ad_events.begin(), ad_events.end()));
+}
+
 void AdsServiceImpl::OnPrefsChanged(const std::string& pref) {
+  if (IsMirroredPref(pref)) {
+    NotifyBatAdsPrefChanged(pref);
+  }
+
   if (pref == ads::prefs::kEnabled) {
     rewards_service_->OnAdsEnabled(IsEnabled());
 
@@ -1862,7 +1972,7 @@ void AdsServiceImpl::RecordAdEvent(const std::string& ad_type,
                                    const std::string& confirmation_type,
                                    const uint64_t timestamp) const {
   FrequencyCappingHelper::GetInstance()->RecordAdEvent(
-      ad_type, confirmation_type, timestamp);
+      ad_type, confirmation_type, timestamp, this);
 }
 
 std::vector<uint64_t> AdsServiceImpl::GetAdEvents(
@@ -1912,6 +2022,8 @@ void AdsServiceImpl::UrlRequest(ads::UrlRequestPtr url_request,
 void AdsServiceImpl::Save(const std::string& name,
                           const std::string& value,
                           ads::ResultCallback callback) {
+  state_bytes_written_ += value.length();
+
   base::PostTaskAndReplyWithResult(
       file_task_runner_.get(), FROM_HERE,
       base::BindOnce(&base::ImportantFileWriter::WriteFileAtomically,
@@ -1989,8 +2101,10 @@ void AdsServiceImpl::RecordP2AEvent(const std::string& name,
         break;
       }
 
+      WeeklyStorageRegistry* weekly_storage_registry =
+          WeeklyStorageRegistryFactory::GetForBrowserContext(profile_);
       for (auto& item : *list) {
-        RecordInWeeklyStorageAndEmitP2AHistogramAnswer(profile_->GetPrefs(),
+        RecordInWeeklyStorageAndEmitP2AHistogramAnswer(weekly_storage_registry,
                                                        item.GetString());
       }
       break;
@@ -2151,4 +2265,14 @@ void AdsServiceImpl::OnForeground() {
   bat_ads_->OnForeground();
 }
 
+void AdsServiceImpl::OnAdEventRecorded(const std::string& ad_type,
+                                       const std::string& confirmation_type,
+                                       const uint64_t timestamp) {
+  if (!connected()) {
+    return;
+  }
+
+  bat_ads_->OnAdEventRecorded(ad_type, confirmation_type, timestamp);
+}
+
 }  // namespace brave_ads
@@ -26,6 +26,7 @@
 #include "brave/components/brave_ads/browser/ads_service.h"
 #include "brave/components/brave_ads/browser/background_helper.h"
 #include "brave/components/brave_ads/browser/component_updater/resource_component.h"
+#include "brave/components/brave_ads/browser/frequency_capping_helper.h"
 #include "brave/components/brave_ads/browser/notification_helper.h"
 #include "brave/components/brave_rewards/browser/rewards_notification_service_observer.h"
 #include "brave/components/services/bat_ads/public/interfaces/bat_ads.mojom.h"
@@ -68,6 +69,7 @@ class AdsServiceImpl : public AdsService,
                        public ads::AdsClient,
                        public history::HistoryServiceObserver,
                        BackgroundHelper::Observer,
+                       FrequencyCappingHelper::Observer,
                        public brave_ads::Observer,
                        public base::SupportsWeakPtr<AdsServiceImpl> {
  public:
@@ -109,11 +111,11 @@ class AdsServiceImpl : public AdsService,
 
   void OnHtmlLoaded(const SessionID& tab_id,
                     const std::vector<GURL>& redirect_chain,
-                    const std::string& html) override;
+                    base::ReadOnlySharedMemoryRegion html) override;
 
   void OnTextLoaded(const SessionID& tab_id,
                     const std::vector<GURL>& redirect_chain,
-                    const std::string& text) override;
+                    base::ReadOnlySharedMemoryRegion text) override;
 
   void OnUserGesture(const int32_t page_transition_type) override;
 
@@ -176,6 +178,11 @@ class AdsServiceImpl : public AdsService,
   // KeyedService implementation
   void Shutdown() override;
 
+  // Binds |bat_ads| in place of bat ads launched in the utility process and
+  // pushes the mirrored prefs and ad events to it
+  void SetBatAdsForTesting(
+      mojo::PendingAssociatedRemote<bat_ads::mojom::BatAds> bat_ads);
+
  private:
   using SimpleURLLoaderList =
       std::list<std::unique_ptr<network::SimpleURLLoader>>;
@@ -215,6 +222,7 @@ class AdsServiceImpl : public AdsService,
   bool IsDebug() const;
 
   void StartCheckIdleStateTimer();
+  void RecordStateBytesWritten();
   void CheckIdleState();
   void ProcessIdleState(const ui::IdleState idle_state, const int idle_time);
   int GetIdleTimeThreshold();
@@ -300,7 +308,10 @@ class AdsServiceImpl : public AdsService,
   bool ShouldShowMyFirstAdNotification() const;
 
   bool PrefExists(const std::string& path) const;
+  void SetBatAdsPrefs();
+  void NotifyBatAdsPrefChanged(const std::string& path);
   void OnPrefsChanged(const std::string& pref);
+  void SetBatAdsAdEvents();
 
   std::string GetLocale() const;
 
@@ -406,6 +417,11 @@ class AdsServiceImpl : public AdsService,
   void OnBackground() override;
   void OnForeground() override;
 
+  // FrequencyCappingHelper::Observer implementation
+  void OnAdEventRecorded(const std::string& ad_type,
+                         const std::string& confirmation_type,
+                         const uint64_t timestamp) override;
+
   ///////////////////////////////////////////////////////////////////////////////
 
   Profile* profile_;  // NOT OWNED
@@ -434,6 +450,11 @@ class AdsServiceImpl : public AdsService,
 
   base::RepeatingTimer idle_poll_timer_;
 
+  // Bytes of ads state, such as client.json, written since the last time it
+  // was recorded. Recorded hourly to measure the write load of browsing
+  size_t state_bytes_written_ = 0;
+  base::RepeatingTimer state_bytes_written_timer_;
+
   PrefChangeRegistrar profile_pref_change_registrar_;
 
   SimpleURLLoaderList url_loaders_;
@@ -0,0 +1,252 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/containers/flat_map.h"
+#include "base/notreached.h"
+#include "base/time/time.h"
+#include "base/values.h"
+#include "bat/ads/pref_names.h"
+#include "brave/browser/brave_ads/ads_service_factory.h"
+#include "brave/components/brave_ads/browser/ads_service_impl.h"
+#include "brave/components/brave_ads/browser/frequency_capping_helper.h"
+#include "brave/components/services/bat_ads/bat_ads_client_mojo_bridge.h"
+#include "brave/components/services/bat_ads/public/cpp/ads_client_mojo_bridge.h"
+#include "brave/components/services/bat_ads/public/interfaces/bat_ads.mojom-test-utils.h"
+#include "chrome/browser/profiles/profile.h"
+#include "chrome/browser/ui/browser.h"
+#include "chrome/test/base/in_process_browser_test.h"
+#include "components/prefs/pref_service.h"
+#include "content/public/test/browser_test.h"
+#include "content/public/test/test_utils.h"
+#include "mojo/public/cpp/bindings/associated_receiver.h"
+#include "testing/gmock/include/gmock/gmock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_browser_tests --filter=BraveAdsMirrorBrowserTest.*
+
+namespace {
+
+const char kAdType[] = "ad_notification";
+const char kConfirmationType[] = "view";
+
+// Forwards the prefs and ad events pushed by AdsServiceImpl to the mirror in
+// |BatAdsClientMojoBridge| as |BatAdsImpl| does in the utility process
+class TestBatAds : public bat_ads::mojom::BatAdsInterceptorForTesting {
+ public:
+  explicit TestBatAds(bat_ads::BatAdsClientMojoBridge* bat_ads_client)
+      : bat_ads_client_(bat_ads_client) {}
+
+  ~TestBatAds() override = default;
+
+  TestBatAds(const TestBatAds&) = delete;
+  TestBatAds& operator=(const TestBatAds&) = delete;
+
+  // BatAdsInterceptorForTesting implementation
+  bat_ads::mojom::BatAds* GetForwardingInterface() override {
+    NOTREACHED();
+    return nullptr;
+  }
+
+  void SetPrefs(base::flat_map<std::string, base::Value> prefs) override {
+    bat_ads_client_->SetPrefs(std::move(prefs));
+  }
+
+  void OnPrefChanged(const std::string& path, base::Value value) override {
+    bat_ads_client_->OnPrefChanged(path, std::move(value));
+  }
+
+  void SetAdEvents(const base::flat_map<std::string, std::vector<uint64_t>>&
+                       ad_events) override {
+    bat_ads_client_->SetAdEvents(ad_events);
+  }
+
+  void OnAdEventRecorded(const std::string& ad_type,
+                         const std::string& confirmation_type,
+                         const uint64_t timestamp) override {
+    bat_ads_client_->OnAdEventRecorded(ad_type, confirmation_type, timestamp);
+  }
+
+ private:
+  bat_ads::BatAdsClientMojoBridge* bat_ads_client_;  // NOT OWNED
+};
+
+}  // namespace
+
+// Connects the mirror in |BatAdsClientMojoBridge| to the AdsServiceImpl of the
+// browser profile over mojo, as in the utility process, and checks that reads
+// from the mirror are consistent with the browser
+class BraveAdsMirrorBrowserTest : public InProcessBrowserTest {
+ public:
+  BraveAdsMirrorBrowserTest() = default;
+
+  ~BraveAdsMirrorBrowserTest() override = default;
+
+  void SetUpOnMainThread() override {
+    InProcessBrowserTest::SetUpOnMainThread();
+
+    ads_service_ = static_cast<brave_ads::AdsServiceImpl*>(
+        brave_ads::AdsServiceFactory::GetForProfile(browser()->profile()));
+    ASSERT_NE(nullptr, ads_service_);
+
+    // Wait for AdsServiceImpl to observe changes to the mirrored prefs
+    content::RunAllTasksUntilIdle();
+  }
+
+  void TearDownOnMainThread() override {
+    bat_ads_receiver_.reset();
+    test_bat_ads_.reset();
+    bat_ads_client_.reset();
+    ads_client_receiver_.reset();
+    ads_client_.reset();
+
+    InProcessBrowserTest::TearDownOnMainThread();
+  }
+
+  void ConnectBatAds() {
+    ads_client_ = std::make_unique<bat_ads::AdsClientMojoBridge>(ads_service_);
+    ads_client_receiver_ = std::make_unique<
+        mojo::AssociatedReceiver<bat_ads::mojom::BatAdsClient>>(
+        ads_client_.get());
+    bat_ads_client_ = std::make_unique<bat_ads::BatAdsClientMojoBridge>(
+        ads_client_receiver_->BindNewEndpointAndPassDedicatedRemote());
+
+    test_bat_ads_ = std::make_unique<TestBatAds>(bat_ads_client_.get());
+    bat_ads_receiver_ =
+        std::make_unique<mojo::AssociatedReceiver<bat_ads::mojom::BatAds>>(
+            test_bat_ads_.get());
+    ads_service_->SetBatAdsForTesting(
+        bat_ads_receiver_->BindNewEndpointAndPassDedicatedRemote());
+
+    content::RunAllTasksUntilIdle();
+  }
+
+  // Closes the pipe to the browser so that a read which is not served by the
+  // mirror returns the default value instead of making a synchronous call
+  void DisconnectFromBrowser() {
+    ads_client_receiver_.reset();
+    content::RunAllTasksUntilIdle();
+  }
+
+  PrefService* GetPrefs() { return browser()->profile()->GetPrefs(); }
+
+  brave_ads::AdsServiceImpl* ads_service_;  // NOT OWNED
+
+  std::unique_ptr<bat_ads::AdsClientMojoBridge> ads_client_;
+  std::unique_ptr<mojo::AssociatedReceiver<bat_ads::mojom::BatAdsClient>>
+      ads_client_receiver_;
+  std::unique_ptr<bat_ads::BatAdsClientMojoBridge> bat_ads_client_;
+  std::unique_ptr<TestBatAds> test_bat_ads_;
+  std::unique_ptr<mojo::AssociatedReceiver<bat_ads::mojom::BatAds>>
+      bat_ads_receiver_;
+};
+
+IN_PROC_BROWSER_TEST_F(BraveAdsMirrorBrowserTest, ReadPrefFromSnapshot) {
+  GetPrefs()->SetUint64(ads::prefs::kAdsPerHour, 3);
+  ConnectBatAds();
+
+  DisconnectFromBrowser();
+
+  EXPECT_EQ(3u, bat_ads_client_->GetUint64Pref(ads::prefs::kAdsPerHour));
+}
+
+IN_PROC_BROWSER_TEST_F(BraveAdsMirrorBrowserTest,
+                       ConsistentAfterWriteFromBatAds) {
+  ConnectBatAds();
+
+  bat_ads_client_->SetUint64Pref(ads::prefs::kAdsPerHour, 2);
+  content::RunAllTasksUntilIdle();
+  DisconnectFromBrowser();
+
+  EXPECT_EQ(2u, GetPrefs()->GetUint64(ads::prefs::kAdsPerHour));
+  EXPECT_EQ(GetPrefs()->GetUint64(ads::prefs::kAdsPerHour),
+            bat_ads_client_->GetUint64Pref(ads::prefs::kAdsPerHour));
+}
+
+IN_PROC_BROWSER_TEST_F(BraveAdsMirrorBrowserTest,
+                       ConsistentAfterBrowserWriteRacesWriteFromBatAds) {
+  ConnectBatAds();
+
+  bat_ads_client_->SetUint64Pref(ads::prefs::kAdsPerHour, 2);
+  GetPrefs()->SetUint64(ads::prefs::kAdsPerHour, 5);
+  content::RunAllTasksUntilIdle();
+  DisconnectFromBrowser();
+
+  EXPECT_EQ(2u, GetPrefs()->GetUint64(ads::prefs::kAdsPerHour));
+  EXPECT_EQ(GetPrefs()->GetUint64(ads::prefs::kAdsPerHour),
+            bat_ads_client_->GetUint64Pref(ads::prefs::kAdsPerHour));
+}
+
+IN_PROC_BROWSER_TEST_F(BraveAdsMirrorBrowserTest,
+                       ConsistentAfterBrowserWriteFollowsWriteFromBatAds) {
+  ConnectBatAds();
+
+  bat_ads_client_->SetUint64Pref(ads::prefs::kAdsPerHour, 2);
+  content::RunAllTasksUntilIdle();
+  GetPrefs()->SetUint64(ads::prefs::kAdsPerHour, 5);
+  content::RunAllTasksUntilIdle();
+  DisconnectFromBrowser();
+
+  EXPECT_EQ(5u, GetPrefs()->GetUint64(ads::prefs::kAdsPerHour));
+  EXPECT_EQ(GetPrefs()->GetUint64(ads::prefs::kAdsPerHour),
+            bat_ads_client_->GetUint64Pref(ads::prefs::kAdsPerHour));
+}
+
+IN_PROC_BROWSER_TEST_F(BraveAdsMirrorBrowserTest,
+                       ConsistentAfterConsecutiveWritesFromBatAds) {
+  ConnectBatAds();
+
+  bat_ads_client_->SetUint64Pref(ads::prefs::kAdsPerHour, 2);
+  bat_ads_client_->SetUint64Pref(ads::prefs::kAdsPerHour, 3);
+  content::RunAllTasksUntilIdle();
+  DisconnectFromBrowser();
+
+  EXPECT_EQ(3u, GetPrefs()->GetUint64(ads::prefs::kAdsPerHour));
+  EXPECT_EQ(GetPrefs()->GetUint64(ads::prefs::kAdsPerHour),
+            bat_ads_client_->GetUint64Pref(ads::prefs::kAdsPerHour));
+}
+
+IN_PROC_BROWSER_TEST_F(BraveAdsMirrorBrowserTest, ReadAdEventsFromSnapshot) {
+  brave_ads::FrequencyCappingHelper* frequency_capping_helper =
+      brave_ads::FrequencyCappingHelper::GetInstance();
+  const uint64_t timestamp =
+      static_cast<uint64_t>(base::Time::Now().ToDoubleT());
+  frequency_capping_helper->RecordAdEvent(kAdType, kConfirmationType,
+                                          timestamp, nullptr);
+  ConnectBatAds();
+
+  DisconnectFromBrowser();
+
+  EXPECT_EQ(frequency_capping_helper->GetAdEvents(kAdType, kConfirmationType),
+            bat_ads_client_->GetAdEvents(kAdType, kConfirmationType));
+}
+
+IN_PROC_BROWSER_TEST_F(BraveAdsMirrorBrowserTest,
+                       ConsistentAfterAdEventsRecordedByBatAdsAndBrowser) {
+  ConnectBatAds();
+
+  // Ad events recorded in the browser with no source, as by another profile,
+  // are pushed to bat ads, while ad events recorded by bat ads are not echoed
+  brave_ads::FrequencyCappingHelper* frequency_capping_helper =
+      brave_ads::FrequencyCappingHelper::GetInstance();
+  const uint64_t timestamp =
+      static_cast<uint64_t>(base::Time::Now().ToDoubleT());
+  bat_ads_client_->RecordAdEvent(kAdType, kConfirmationType, timestamp);
+  frequency_capping_helper->RecordAdEvent(kAdType, kConfirmationType,
+                                          timestamp + 1, nullptr);
+  content::RunAllTasksUntilIdle();
+  DisconnectFromBrowser();
+
+  const std::vector<uint64_t> ad_events =
+      frequency_capping_helper->GetAdEvents(kAdType, kConfirmationType);
+  EXPECT_EQ(2u, ad_events.size());
+  EXPECT_THAT(bat_ads_client_->GetAdEvents(kAdType, kConfirmationType),
+              ::testing::UnorderedElementsAreArray(ad_events));
+}
@@ -15,10 +15,27 @@ FrequencyCappingHelper* FrequencyCappingHelper::GetInstance() {
   return base::Singleton<FrequencyCappingHelper>::get();
 }
 
+void FrequencyCappingHelper::AddObserver(Observer* observer) {
+  observers_.AddObserver(observer);
+}
+
+void FrequencyCappingHelper::RemoveObserver(Observer* observer) {
+  observers_.RemoveObserver(observer);
+}
+
 void FrequencyCappingHelper::RecordAdEvent(const std::string& ad_type,
                                            const std::string& confirmation_type,
-                                           const uint64_t timestamp) {
+                                           const uint64_t timestamp,
+                                           const Observer* source) {
   ad_event_history_.Record(ad_type, confirmation_type, timestamp);
+
+  for (auto& observer : observers_) {
+    if (&observer == source) {
+      continue;
+    }
+
+    observer.OnAdEventRecorded(ad_type, confirmation_type, timestamp);
+  }
 }
 
 std::vector<uint64_t> FrequencyCappingHelper::GetAdEvents(
@@ -27,4 +44,9 @@ std::vector<uint64_t> FrequencyCappingHelper::GetAdEvents(
   return ad_event_history_.Get(ad_type, confirmation_type);
 }
 
+const ads::AdEventHistory::History& FrequencyCappingHelper::GetAllAdEvents()
+    const {
+  return ad_event_history_.GetAll();
+}
+
 }  // namespace brave_ads
@@ -11,21 +11,37 @@
 #include <vector>
 
 #include "base/memory/singleton.h"
+#include "base/observer_list.h"
 #include "bat/ads/ad_event_history.h"
 
 namespace brave_ads {
 
 class FrequencyCappingHelper {
  public:
+  class Observer {
+   public:
+    virtual void OnAdEventRecorded(const std::string& ad_type,
+                                   const std::string& confirmation_type,
+                                   const uint64_t timestamp) = 0;
+  };
+
   static FrequencyCappingHelper* GetInstance();
 
+  void AddObserver(Observer* observer);
+  void RemoveObserver(Observer* observer);
+
+  // Records an ad event and notifies observers other than |source|, which has
+  // already recorded the ad event
   void RecordAdEvent(const std::string& ad_type,
                      const std::string& confirmation_type,
-                     const uint64_t timestamp);
+                     const uint64_t timestamp,
+                     const Observer* source);
 
   std::vector<uint64_t> GetAdEvents(const std::string& ad_type,
                                     const std::string& confirmation_type) const;
 
+  const ads::AdEventHistory::History& GetAllAdEvents() const;
+
  private:
   friend struct base::DefaultSingletonTraits<FrequencyCappingHelper>;
 
@@ -34,6 +50,8 @@ class FrequencyCappingHelper {
 
   ads::AdEventHistory ad_event_history_;
 
+  base::ObserverList<Observer>::Unchecked observers_;
+
   FrequencyCappingHelper(const FrequencyCappingHelper&) = delete;
   FrequencyCappingHelper& operator=(const FrequencyCappingHelper&) = delete;
 };
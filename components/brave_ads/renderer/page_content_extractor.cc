@@ -0,0 +1,115 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_ads/renderer/page_content_extractor.h"
+
+#include <string>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/memory/read_only_shared_memory_region.h"
+#include "base/metrics/histogram_macros.h"
+#include "base/strings/string_util.h"
+#include "base/time/time.h"
+#include "content/public/renderer/render_frame.h"
+#include "third_party/blink/public/common/associated_interfaces/associated_interface_registry.h"
+#include "third_party/blink/public/platform/web_string.h"
+#include "third_party/blink/public/web/web_frame_content_dumper.h"
+#include "third_party/blink/public/web/web_local_frame.h"
+
+namespace brave_ads {
+
+namespace {
+
+// Truncates |content| to at most |max_length| bytes without splitting a UTF-8
+// character
+void TruncateContent(const size_t max_length, std::string* content) {
+  if (content->length() <= max_length) {
+    return;
+  }
+
+  base::TruncateUTF8ToByteSize(*content, max_length, content);
+}
+
+base::ReadOnlySharedMemoryRegion CopyToSharedMemory(
+    const std::string& content) {
+  if (content.empty()) {
+    return base::ReadOnlySharedMemoryRegion();
+  }
+
+  base::MappedReadOnlyRegion region_and_mapping =
+      base::ReadOnlySharedMemoryRegion::Create(content.length());
+  if (!region_and_mapping.IsValid()) {
+    return base::ReadOnlySharedMemoryRegion();
+  }
+
+  memcpy(region_and_mapping.mapping.memory(), content.data(),
+         content.length());
+
+  return std::move(region_and_mapping.region);
+}
+
+}  // namespace
+
+PageContentExtractor::PageContentExtractor(content::RenderFrame* render_frame)
+    : RenderFrameObserver(render_frame) {
+  render_frame->GetAssociatedInterfaceRegistry()->AddInterface(
+      base::BindRepeating(&PageContentExtractor::BindReceiver,
+                          base::Unretained(this)));
+}
+
+PageContentExtractor::~PageContentExtractor() = default;
+
+void PageContentExtractor::BindReceiver(
+    mojo::PendingAssociatedReceiver<mojom::PageContentExtractor> receiver) {
+  receiver_.reset();
+  receiver_.Bind(std::move(receiver));
+}
+
+void PageContentExtractor::ExtractPageContent(
+    uint32_t max_text_length,
+    ExtractPageContentCallback callback) {
+  blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
+
+  const base::TimeTicks start_time = base::TimeTicks::Now();
+
+  // The whole document is serialized, as it was by the XMLSerializer script
+  // this replaces. Conversion id patterns are arbitrary regular expressions
+  // which can match anywhere in the markup, so there is no smaller part of the
+  // document which could be extracted instead
+  const std::string html =
+      blink::WebFrameContentDumper::DumpAsMarkup(frame).Utf8();
+
+  // Text is extracted in a single walk over the layout tree which stops once
+  // |max_text_length| characters have been collected. Unlike the
+  // document.body.innerText it replaces, this includes the text of same
+  // process child frames, such as same site embedded articles or comments.
+  // Cross site frames, such as third party ads, are out of process with site
+  // isolation and are not included
+  std::string text =
+      blink::WebFrameContentDumper::DumpFrameTreeAsText(frame, max_text_length)
+          .Utf8();
+  TruncateContent(max_text_length, &text);
+
+  base::ReadOnlySharedMemoryRegion html_region = CopyToSharedMemory(html);
+  base::ReadOnlySharedMemoryRegion text_region = CopyToSharedMemory(text);
+
+  UMA_HISTOGRAM_TIMES("Brave.Ads.PageContentExtractor.MainThreadTime",
+                      base::TimeTicks::Now() - start_time);
+
+  // Page content is copied into shared memory here and once more out of it by
+  // bat ads, which is the only process to map it
+  UMA_HISTOGRAM_MEMORY_KB("Brave.Ads.PageContentExtractor.SharedMemorySize",
+                          (html_region.GetSize() + text_region.GetSize()) /
+                              1024);
+
+  std::move(callback).Run(std::move(html_region), std::move(text_region));
+}
+
+void PageContentExtractor::OnDestruct() {
+  delete this;
+}
+
+}  // namespace brave_ads
@@ -0,0 +1,47 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_ADS_RENDERER_PAGE_CONTENT_EXTRACTOR_H_
+#define BRAVE_COMPONENTS_BRAVE_ADS_RENDERER_PAGE_CONTENT_EXTRACTOR_H_
+
+#include <cstdint>
+
+#include "brave/components/brave_ads/common/page_content_extractor.mojom.h"
+#include "content/public/renderer/render_frame_observer.h"
+#include "mojo/public/cpp/bindings/associated_receiver.h"
+#include "mojo/public/cpp/bindings/pending_associated_receiver.h"
+
+namespace brave_ads {
+
+// Extracts the content of main frame documents for ads when requested by the
+// browser. Text is truncated in the renderer, and content is handed over as
+// shared memory rather than by evaluating script which returns the whole
+// document as a value.
+class PageContentExtractor : public content::RenderFrameObserver,
+                             public mojom::PageContentExtractor {
+ public:
+  explicit PageContentExtractor(content::RenderFrame* render_frame);
+  ~PageContentExtractor() override;
+
+  PageContentExtractor(const PageContentExtractor&) = delete;
+  PageContentExtractor& operator=(const PageContentExtractor&) = delete;
+
+  // mojom::PageContentExtractor implementation.
+  void ExtractPageContent(uint32_t max_text_length,
+                          ExtractPageContentCallback callback) override;
+
+ private:
+  void BindReceiver(
+      mojo::PendingAssociatedReceiver<mojom::PageContentExtractor> receiver);
+
+  // RenderFrameObserver implementation.
+  void OnDestruct() override;
+
+  mojo::AssociatedReceiver<mojom::PageContentExtractor> receiver_{this};
+};
+
+}  // namespace brave_ads
+
+#endif  // BRAVE_COMPONENTS_BRAVE_ADS_RENDERER_PAGE_CONTENT_EXTRACTOR_H_
@@ -0,0 +1,76 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_ads/renderer/page_content_extractor.h"
+
+#include <string>
+
+#include "base/bind.h"
+#include "base/memory/read_only_shared_memory_region.h"
+#include "base/strings/strcat.h"
+#include "content/public/renderer/render_frame.h"
+#include "content/public/renderer/render_view.h"
+#include "content/public/test/render_view_test.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave_ads {
+
+namespace {
+
+std::string ReadSharedMemoryRegion(
+    const base::ReadOnlySharedMemoryRegion& region) {
+  if (!region.IsValid()) {
+    return "";
+  }
+
+  const base::ReadOnlySharedMemoryMapping mapping = region.Map();
+  return std::string(static_cast<const char*>(mapping.memory()),
+                     mapping.size());
+}
+
+}  // namespace
+
+class PageContentExtractorBrowserTest : public content::RenderViewTest {
+ protected:
+  void ExtractPageContent(const uint32_t max_text_length,
+                          std::string* html,
+                          std::string* text) {
+    // Deleted when the render frame is destroyed
+    PageContentExtractor* extractor =
+        new PageContentExtractor(view_->GetMainRenderFrame());
+
+    extractor->ExtractPageContent(
+        max_text_length,
+        base::BindOnce(
+            [](std::string* html, std::string* text,
+               base::ReadOnlySharedMemoryRegion html_region,
+               base::ReadOnlySharedMemoryRegion text_region) {
+              *html = ReadSharedMemoryRegion(html_region);
+              *text = ReadSharedMemoryRegion(text_region);
+            },
+            html, text));
+  }
+};
+
+TEST_F(PageContentExtractorBrowserTest, TruncatesTextButNotHtml) {
+  const std::string padding(1024, 'x');
+  LoadHTMLWithUrlOverride(
+      base::StrCat({"<html><body><p>", padding,
+                    "</p><meta name=\"ad-conversion-id\" content=\"abc123\">"
+                    "</body></html>"})
+          .c_str(),
+      "https://example.com/");
+
+  std::string html;
+  std::string text;
+  ExtractPageContent(16, &html, &text);
+
+  EXPECT_NE(std::string::npos, html.find(padding));
+  EXPECT_NE(std::string::npos, html.find("abc123"));
+  EXPECT_LE(text.length(), 16UL);
+  EXPECT_FALSE(text.empty());
+}
+
+}  // namespace brave_ads
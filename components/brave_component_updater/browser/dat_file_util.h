@@ -12,6 +12,8 @@
 #include <vector>
 
 #include "base/files/file_path.h"
+#include "base/files/memory_mapped_file.h"
+#include "base/logging.h"
 
 namespace brave_component_updater {
 
@@ -41,6 +43,30 @@ LoadDATFileDataResult<T> LoadDATFileData(
       std::move(client), std::move(buffer));
 }
 
+// Deserializes |T| directly from a read-only mapping of the DAT file, so the
+// file is never copied into an intermediate buffer. Only use this for types
+// which do not reference the serialized data after |deserialize| returns, as
+// the file is unmapped before returning. Returns nullptr on failure.
+template<typename T>
+std::unique_ptr<T> LoadMappedDATFileData(const base::FilePath& dat_file_path) {
+  base::MemoryMappedFile mapped_file;
+  if (!mapped_file.Initialize(dat_file_path) || 0 == mapped_file.length()) {
+    LOG(ERROR) << "LoadMappedDATFileData: "
+               << "the dat file is not found or corrupted "
+               << dat_file_path;
+    return nullptr;
+  }
+
+  std::unique_ptr<T> client = std::make_unique<T>();
+  if (!client->deserialize(reinterpret_cast<const char*>(mapped_file.data()),
+                           mapped_file.length())) {
+    LOG(ERROR) << "LoadMappedDATFileData: cannot "
+               << "deserialize dat file " << dat_file_path;
+    return nullptr;
+  }
+
+  return client;
+}
 
 }  // namespace brave_component_updater
 
@@ -9,8 +9,8 @@
 #include <utility>
 
 #include "base/test/metrics/histogram_tester.h"
-#include "base/test/simple_test_clock.h"
-#include "base/time/time.h"
+#include "base/test/task_environment.h"
+#include "brave/components/weekly_storage/weekly_storage_registry.h"
 #include "components/prefs/testing_pref_service.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -21,16 +21,16 @@ constexpr char kSavingsDailyUMAHistogramName[] =
 
 class P3ABandwidthSavingsTrackerTest : public ::testing::Test {
  public:
-  P3ABandwidthSavingsTrackerTest() : clock_(new base::SimpleTestClock) {
+  P3ABandwidthSavingsTrackerTest() {
     P3ABandwidthSavingsTracker::RegisterPrefs(pref_service_.registry());
-    tracker_ = std::make_unique<P3ABandwidthSavingsTracker>(
-        &pref_service_, std::unique_ptr<base::Clock>(clock_));
-    clock_->SetNow(base::Time::Now());
+    registry_ = std::make_unique<WeeklyStorageRegistry>(&pref_service_);
+    tracker_ = std::make_unique<P3ABandwidthSavingsTracker>(registry_.get());
   }
 
  protected:
-  base::SimpleTestClock* clock_;
+  base::test::TaskEnvironment task_environment_;
   TestingPrefServiceSimple pref_service_;
+  std::unique_ptr<WeeklyStorageRegistry> registry_;
   std::unique_ptr<P3ABandwidthSavingsTracker> tracker_;
 };
 
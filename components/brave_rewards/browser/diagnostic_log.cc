@@ -5,6 +5,7 @@
 
 #include "brave/components/brave_rewards/browser/diagnostic_log.h"
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 
@@ -20,6 +21,15 @@ namespace {
 const int64_t kChunkSize = 1024;
 const size_t kDividerLength = 80;
 
+// Buffered log entries are written after this delay or as soon as the buffer
+// exceeds the maximum buffer size
+const int64_t kFlushDelayInSeconds = 1;
+const size_t kMaxBufferSize = 64 * 1024;
+
+base::FilePath GetPreviousSegmentPath(const base::FilePath& file_path) {
+  return file_path.AddExtensionASCII("1");
+}
+
 std::string FormatTime(const base::Time& time) {
   return base::UTF16ToUTF8(
       base::TimeFormatWithPattern(time, "MMM dd, YYYY h::mm::ss.S a"));
@@ -142,78 +152,8 @@ int64_t SeekFromEnd(base::File* file, int num_lines) {
   return length;
 }
 
-bool TrimBeginningOfFile(base::File* file, int keep_num_lines) {
-  DCHECK(file);
-
-  if (file->GetLength() == 0) {
-    return true;
-  }
-
-  const int64_t offset = SeekFromEnd(file, keep_num_lines);
-  if (offset == -1) {
-    return false;
-  }
-
-  if (offset == 0) {
-    return true;
-  }
-
-  if (file->Seek(base::File::FROM_BEGIN, offset) == -1) {
-    return false;
-  }
-
-  const int64_t size = file->GetLength() - offset;
-  std::unique_ptr<char[]> buffer = std::make_unique<char[]>(size + 1);
-
-  if (file->ReadAtCurrentPos(buffer.get(), size) == -1) {
-    return false;
-  }
-
-  if (file->Seek(base::File::FROM_BEGIN, 0) == -1) {
-    return false;
-  }
-
-  const std::string data = std::string(buffer.get());
-  const int64_t new_size = data.size();
-
-  if (file->WriteAtCurrentPos(data.c_str(), new_size) == -1) {
-    return false;
-  }
-
-  if (!file->SetLength(new_size)) {
-    return false;
-  }
-
-  return true;
-}
-
-bool MaybeTrimBeginningOfFile(base::File* file,
-                              int64_t max_file_size,
-                              int keep_num_lines,
-                              bool first_write) {
-  DCHECK(file);
-
-  const int64_t length = file->GetLength();
-  if (length == -1) {
-    return false;
-  }
-
-  // We do not trim the log on first run so that if the browser
-  // crashes and we investigate the log with the user they are able to
-  // re-run the browser without losing past logs.
-  if (!first_write && length <= max_file_size) {
-    return true;
-  }
-
-  if (!TrimBeginningOfFile(file, keep_num_lines)) {
-    return false;
-  }
-
-  return true;
-}
-
-std::string ReadLastNLinesOnFileTaskRunner(const base::FilePath& file_path,
-                                           int num_lines) {
+std::string ReadLastNLinesOfFile(const base::FilePath& file_path,
+                                 int num_lines) {
   base::File file;
   if (!Open(file_path, &file)) {
     return "";
@@ -248,10 +188,27 @@ std::string ReadLastNLinesOnFileTaskRunner(const base::FilePath& file_path,
   return std::string(buffer.get());
 }
 
+std::string ReadLastNLinesOnFileTaskRunner(const base::FilePath& file_path,
+                                           int num_lines) {
+  const std::string data = ReadLastNLinesOfFile(file_path, num_lines);
+
+  int remaining_num_lines = -1;
+  if (num_lines != -1) {
+    remaining_num_lines =
+        num_lines - std::count(data.begin(), data.end(), '\n');
+    if (remaining_num_lines <= 0) {
+      return data;
+    }
+  }
+
+  return ReadLastNLinesOfFile(GetPreviousSegmentPath(file_path),
+                              remaining_num_lines) +
+         data;
+}
+
 bool WriteOnFileTaskRunner(const base::FilePath& file_path,
-                           const std::string& log_entry,
+                           const std::string& log_entries,
                            int64_t max_file_size,
-                           int keep_num_lines,
                            bool first_write) {
   base::File file;
   if (!CreateOrOpen(file_path, &file)) {
@@ -267,16 +224,30 @@ bool WriteOnFileTaskRunner(const base::FilePath& file_path,
     file.WriteAtCurrentPos(divider.c_str(), divider.length());
   }
 
-  if (file.WriteAtCurrentPos(log_entry.c_str(), log_entry.length()) == -1) {
+  if (file.WriteAtCurrentPos(log_entries.c_str(), log_entries.length()) ==
+      -1) {
+    return false;
+  }
+
+  const int64_t length = file.GetLength();
+  if (length == -1) {
     return false;
   }
 
-  return MaybeTrimBeginningOfFile(&file, max_file_size, keep_num_lines,
-                                  first_write);
+  if (length <= max_file_size / 2) {
+    return true;
+  }
+
+  // Start a new segment, replacing the previous segment
+  file.Close();
+  return base::ReplaceFile(file_path, GetPreviousSegmentPath(file_path),
+                           nullptr);
 }
 
 bool DeleteOnFileTaskRunner(const base::FilePath& file_path) {
-  return base::DeleteFile(file_path);
+  const bool deleted_previous_segment =
+      base::DeleteFile(GetPreviousSegmentPath(file_path));
+  return base::DeleteFile(file_path) && deleted_previous_segment;
 }
 
 }  // namespace
@@ -284,22 +255,32 @@ bool DeleteOnFileTaskRunner(const base::FilePath& file_path) {
 namespace brave_rewards {
 
 DiagnosticLog::DiagnosticLog(const base::FilePath& file_path,
-                             int64_t max_file_size,
-                             int keep_num_lines)
+                             int64_t max_file_size)
     : file_task_runner_(base::ThreadPool::CreateSequencedTaskRunner(
           {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
            base::TaskShutdownBehavior::BLOCK_SHUTDOWN})),
       file_path_(file_path),
       max_file_size_(max_file_size),
-      keep_num_lines_(keep_num_lines),
       first_write_(true) {}
 
 DiagnosticLog::~DiagnosticLog() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  if (pending_log_entries_.empty()) {
+    return;
+  }
+
+  file_task_runner_->PostTask(
+      FROM_HERE,
+      base::BindOnce(base::IgnoreResult(&WriteOnFileTaskRunner), file_path_,
+                     std::move(pending_log_entries_), max_file_size_,
+                     first_write_));
 }
 
 void DiagnosticLog::ReadLastNLines(int num_lines, ReadCallback callback) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  Flush();
+
   file_task_runner_->PostTaskAndReplyWithResult(
       FROM_HERE,
       base::BindOnce(&ReadLastNLinesOnFileTaskRunner, file_path_, num_lines),
@@ -310,13 +291,19 @@ void DiagnosticLog::ReadLastNLines(int num_lines, ReadCallback callback) {
 void DiagnosticLog::Write(const std::string& log_entry,
                           StatusCallback callback) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
-  file_task_runner_->PostTaskAndReplyWithResult(
-      FROM_HERE,
-      base::BindOnce(&WriteOnFileTaskRunner, file_path_, log_entry,
-                     max_file_size_, keep_num_lines_, first_write_),
-      base::BindOnce(&DiagnosticLog::OnWrite, AsWeakPtr(),
-                     std::move(callback)));
-  first_write_ = false;
+  pending_log_entries_.append(log_entry);
+  pending_callbacks_.push_back(std::move(callback));
+
+  if (pending_log_entries_.size() >= kMaxBufferSize) {
+    Flush();
+    return;
+  }
+
+  if (!flush_timer_.IsRunning()) {
+    flush_timer_.Start(FROM_HERE,
+                       base::TimeDelta::FromSeconds(kFlushDelayInSeconds),
+                       base::BindOnce(&DiagnosticLog::Flush, AsWeakPtr()));
+  }
 }
 
 void DiagnosticLog::Write(const std::string& log_entry,
@@ -338,25 +325,57 @@ void DiagnosticLog::Write(const std::string& log_entry,
       filename.c_str(), line, log_entry.c_str());
 
   Write(formatted_log_entry, std::move(callback));
+
+  if (verbose_level == 0) {
+    Flush();
+  }
 }
 
 void DiagnosticLog::Delete(StatusCallback callback) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  Flush();
+
   file_task_runner_->PostTaskAndReplyWithResult(
       FROM_HERE, base::BindOnce(&DeleteOnFileTaskRunner, file_path_),
       base::BindOnce(&DiagnosticLog::OnDelete, AsWeakPtr(),
                      std::move(callback)));
 }
 
+void DiagnosticLog::Flush() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  flush_timer_.Stop();
+
+  if (pending_log_entries_.empty()) {
+    return;
+  }
+
+  std::string log_entries;
+  log_entries.swap(pending_log_entries_);
+
+  std::vector<StatusCallback> callbacks;
+  callbacks.swap(pending_callbacks_);
+
+  file_task_runner_->PostTaskAndReplyWithResult(
+      FROM_HERE,
+      base::BindOnce(&WriteOnFileTaskRunner, file_path_,
+                     std::move(log_entries), max_file_size_, first_write_),
+      base::BindOnce(&DiagnosticLog::OnWrite, AsWeakPtr(),
+                     std::move(callbacks)));
+  first_write_ = false;
+}
+
 void DiagnosticLog::OnReadLastNLines(ReadCallback callback,
                                      const std::string& data) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   std::move(callback).Run(data);
 }
 
-void DiagnosticLog::OnWrite(StatusCallback callback, bool result) {
+void DiagnosticLog::OnWrite(std::vector<StatusCallback> callbacks,
+                            bool result) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
-  std::move(callback).Run(result);
+  for (auto& callback : callbacks) {
+    std::move(callback).Run(result);
+  }
 }
 
 void DiagnosticLog::OnDelete(StatusCallback callback, bool result) {
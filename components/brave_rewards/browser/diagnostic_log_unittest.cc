@@ -0,0 +1,211 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_rewards/browser/diagnostic_log.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/run_loop.h"
+#include "base/test/task_environment.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=DiagnosticLogTest.*
+
+namespace brave_rewards {
+
+namespace {
+
+const int64_t kMaxFileSize = 200;
+const size_t kMaxBufferSize = 64 * 1024;
+
+const char kDivider[] =
+    "----------------------------------------"
+    "----------------------------------------\n";
+
+}  // namespace
+
+class DiagnosticLogTest : public testing::Test {
+ public:
+  DiagnosticLogTest() {}
+  ~DiagnosticLogTest() override {}
+
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    path_ = temp_dir_.GetPath().AppendASCII("Rewards.log");
+    diagnostic_log_ = std::make_unique<DiagnosticLog>(path_, kMaxFileSize);
+  }
+
+  void TearDown() override {
+    diagnostic_log_.reset();
+    task_environment_.RunUntilIdle();
+  }
+
+  void Write(const std::string& log_entry) {
+    diagnostic_log_->Write(
+        log_entry,
+        base::BindOnce(&DiagnosticLogTest::OnWrite, base::Unretained(this)));
+  }
+
+  void Write(const std::string& log_entry, int verbose_level) {
+    diagnostic_log_->Write(
+        log_entry, base::Time::Now(), "diagnostic_log_unittest.cc", 1,
+        verbose_level,
+        base::BindOnce(&DiagnosticLogTest::OnWrite, base::Unretained(this)));
+  }
+
+  std::string ReadLastNLines(int num_lines) {
+    std::string data;
+    base::RunLoop run_loop;
+    diagnostic_log_->ReadLastNLines(
+        num_lines, base::BindOnce(&DiagnosticLogTest::OnReadLastNLines,
+                                  base::Unretained(this), &data,
+                                  run_loop.QuitClosure()));
+    run_loop.Run();
+    return data;
+  }
+
+  std::string ReadFile(const base::FilePath& path) {
+    std::string data;
+    if (!base::ReadFileToString(path, &data)) {
+      return "";
+    }
+
+    return data;
+  }
+
+  base::FilePath previous_segment_path() const {
+    return path_.AddExtensionASCII("1");
+  }
+
+  // Need this as a very first member to run tests with mock time
+  base::test::TaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+  base::ScopedTempDir temp_dir_;
+  base::FilePath path_;
+  std::unique_ptr<DiagnosticLog> diagnostic_log_;
+  int write_count_ = 0;
+  int failed_write_count_ = 0;
+
+ private:
+  void OnWrite(bool result) {
+    write_count_++;
+    if (!result) {
+      failed_write_count_++;
+    }
+  }
+
+  void OnReadLastNLines(std::string* data,
+                        base::OnceClosure quit_closure,
+                        const std::string& result) {
+    *data = result;
+    std::move(quit_closure).Run();
+  }
+};
+
+TEST_F(DiagnosticLogTest, BufferWritesUntilFlushDelay) {
+  Write("line 1\n");
+  Write("line 2\n");
+  task_environment_.RunUntilIdle();
+
+  EXPECT_EQ(0, write_count_);
+  EXPECT_FALSE(base::PathExists(path_));
+
+  task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(1));
+
+  EXPECT_EQ(2, write_count_);
+  EXPECT_EQ(0, failed_write_count_);
+  EXPECT_EQ(std::string(kDivider) + "line 1\nline 2\n", ReadFile(path_));
+}
+
+TEST_F(DiagnosticLogTest, FlushImmediatelyOnError) {
+  Write("info", 1);
+  task_environment_.RunUntilIdle();
+
+  EXPECT_EQ(0, write_count_);
+  EXPECT_FALSE(base::PathExists(path_));
+
+  Write("error", 0);
+  task_environment_.RunUntilIdle();
+
+  EXPECT_EQ(2, write_count_);
+  EXPECT_EQ(0, failed_write_count_);
+  const std::string data = ReadFile(path_);
+  EXPECT_NE(std::string::npos, data.find(":INFO:"));
+  EXPECT_NE(std::string::npos, data.find(":ERROR:"));
+  EXPECT_LT(data.find("] info\n"), data.find("] error\n"));
+}
+
+TEST_F(DiagnosticLogTest, FlushWhenBufferReachesMaximumSize) {
+  Write(std::string(kMaxBufferSize - 2, 'a'));
+  task_environment_.RunUntilIdle();
+
+  EXPECT_EQ(0, write_count_);
+  EXPECT_FALSE(base::PathExists(path_));
+
+  Write("a\n");
+  task_environment_.RunUntilIdle();
+
+  EXPECT_EQ(2, write_count_);
+  EXPECT_EQ(0, failed_write_count_);
+  EXPECT_EQ(std::string(kDivider) + std::string(kMaxBufferSize - 1, 'a') + "\n",
+            ReadFile(previous_segment_path()));
+}
+
+TEST_F(DiagnosticLogTest, RotateWhenFileExceedsHalfOfMaximumSize) {
+  const std::string line_1 = std::string(kMaxFileSize / 2, '1') + "\n";
+  Write(line_1);
+  task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(1));
+
+  EXPECT_FALSE(base::PathExists(path_));
+  EXPECT_EQ(std::string(kDivider) + line_1, ReadFile(previous_segment_path()));
+
+  Write("line 2\n");
+  task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(1));
+
+  EXPECT_EQ("line 2\n", ReadFile(path_));
+  EXPECT_EQ(std::string(kDivider) + line_1, ReadFile(previous_segment_path()));
+
+  const std::string line_3 = std::string(kMaxFileSize / 2, '3') + "\n";
+  Write(line_3);
+  task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(1));
+
+  EXPECT_FALSE(base::PathExists(path_));
+  EXPECT_EQ("line 2\n" + line_3, ReadFile(previous_segment_path()));
+  EXPECT_EQ(3, write_count_);
+  EXPECT_EQ(0, failed_write_count_);
+}
+
+TEST_F(DiagnosticLogTest, ReadLastNLinesSpanningSegments) {
+  const std::string long_line = std::string(kMaxFileSize / 2, 'x') + "\n";
+  Write("line 1\n");
+  Write("line 2\n");
+  Write(long_line);
+  task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(1));
+  ASSERT_TRUE(base::PathExists(previous_segment_path()));
+
+  Write("line 3\n");
+  Write("line 4\n");
+
+  // Reading flushes pending log entries before reading the log
+  EXPECT_EQ("line 4\n", ReadLastNLines(1));
+  EXPECT_EQ("line 3\nline 4\n", ReadLastNLines(2));
+  EXPECT_EQ(long_line + "line 3\nline 4\n", ReadLastNLines(3));
+  EXPECT_EQ("line 2\n" + long_line + "line 3\nline 4\n", ReadLastNLines(4));
+  EXPECT_EQ(std::string(kDivider) + "line 1\nline 2\n" + long_line +
+                "line 3\nline 4\n",
+            ReadLastNLines(100));
+  EXPECT_EQ(std::string(kDivider) + "line 1\nline 2\n" + long_line +
+                "line 3\nline 4\n",
+            ReadLastNLines(-1));
+}
+
+}  // namespace brave_rewards
@@ -6,6 +6,7 @@
 #include "brave/components/brave_shields/browser/ad_block_base_service.h"
 
 #include <algorithm>
+#include <atomic>
 #include <string>
 #include <utility>
 #include <vector>
@@ -32,6 +33,8 @@ using namespace net::registry_controlled_domains;  // NOLINT
 
 namespace {
 
+std::atomic<uint64_t> g_engine_generation(0);
+
 std::string ResourceTypeToString(blink::mojom::ResourceType resource_type) {
   std::string filter_option = "";
   switch (resource_type) {
@@ -102,6 +105,23 @@ std::string ResourceTypeToString(blink::mojom::ResourceType resource_type) {
 
 namespace brave_shields {
 
+AdBlockRequestInfo::AdBlockRequestInfo(const GURL& url,
+                                       blink::mojom::ResourceType resource_type,
+                                       const std::string& tab_host)
+    : url_spec(url.spec()),
+      host(url.host()),
+      tab_host(tab_host),
+      // Determine third-party here so the library doesn't need to figure it
+      // out. CreateFromNormalizedTuple is needed because SameDomainOrHost
+      // needs a URL or origin and not a string to a host name.
+      is_third_party(!SameDomainOrHost(
+          url,
+          url::Origin::CreateFromNormalizedTuple("https", tab_host.c_str(), 80),
+          INCLUDE_PRIVATE_REGISTRIES)),
+      resource_type(ResourceTypeToString(resource_type)) {}
+
+AdBlockRequestInfo::~AdBlockRequestInfo() = default;
+
 AdBlockBaseService::AdBlockBaseService(BraveComponent::Delegate* delegate)
     : BaseBraveShieldsService(delegate),
       ad_block_client_(new adblock::Engine()),
@@ -119,24 +139,23 @@ void AdBlockBaseService::ShouldStartRequest(
     bool* did_match_exception,
     bool* did_match_important,
     std::string* mock_data_url) {
+  const AdBlockRequestInfo request_info(url, resource_type, tab_host);
+  ShouldStartRequest(request_info, did_match_rule, did_match_exception,
+                     did_match_important, mock_data_url);
+}
+
+void AdBlockBaseService::ShouldStartRequest(
+    const AdBlockRequestInfo& request_info,
+    bool* did_match_rule,
+    bool* did_match_exception,
+    bool* did_match_important,
+    std::string* mock_data_url) {
   DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
 
-  // Determine third-party here so the library doesn't need to figure it out.
-  // CreateFromNormalizedTuple is needed because SameDomainOrHost needs
-  // a URL or origin and not a string to a host name.
-  bool is_third_party = !SameDomainOrHost(
-      url,
-      url::Origin::CreateFromNormalizedTuple("https", tab_host.c_str(), 80),
-      INCLUDE_PRIVATE_REGISTRIES);
   ad_block_client_->matches(
-      url.spec(), url.host(), tab_host, is_third_party,
-      ResourceTypeToString(resource_type), did_match_rule,
+      request_info.url_spec, request_info.host, request_info.tab_host,
+      request_info.is_third_party, request_info.resource_type, did_match_rule,
       did_match_exception, did_match_important, mock_data_url);
-
-  // LOG(ERROR) << "AdBlockBaseService::ShouldStartRequest(), host: "
-  //  << tab_host
-  //  << ", resource type: " << resource_type
-  //  << ", url.spec(): " << url.spec();
 }
 
 base::Optional<std::string> AdBlockBaseService::GetCspDirectives(
@@ -182,6 +201,7 @@ void AdBlockBaseService::EnableTag(const std::string& tag, bool enabled) {
       tags_.erase(it);
     }
   }
+  OnEngineChanged();
 }
 
 void AdBlockBaseService::AddResources(const std::string& resources) {
@@ -194,6 +214,17 @@ void AdBlockBaseService::AddResources(const std::string& resources) {
 
   ad_block_client_->addResources(resources);
   resources_ = resources;
+  OnEngineChanged();
+}
+
+// static
+uint64_t AdBlockBaseService::GetEngineGeneration() {
+  return g_engine_generation.load();
+}
+
+// static
+void AdBlockBaseService::OnEngineChanged() {
+  g_engine_generation++;
 }
 
 bool AdBlockBaseService::TagExists(const std::string& tag) {
@@ -206,6 +237,11 @@ base::Optional<base::Value> AdBlockBaseService::UrlCosmeticResources(
   return base::JSONReader::Read(ad_block_client_->urlCosmeticResources(url));
 }
 
+bool AdBlockBaseService::UrlGenericHide(const std::string& url) {
+  DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
+  return ad_block_client_->urlGenericHide(url);
+}
+
 base::Optional<base::Value> AdBlockBaseService::HiddenClassIdSelectors(
         const std::vector<std::string>& classes,
         const std::vector<std::string>& ids,
@@ -218,33 +254,37 @@ base::Optional<base::Value> AdBlockBaseService::HiddenClassIdSelectors(
 void AdBlockBaseService::GetDATFileData(const base::FilePath& dat_file_path) {
   base::ThreadPool::PostTaskAndReplyWithResult(
       FROM_HERE, {base::MayBlock()},
-      base::BindOnce(&brave_component_updater::LoadDATFileData<adblock::Engine>,
-                     dat_file_path),
+      base::BindOnce(
+          &brave_component_updater::LoadMappedDATFileData<adblock::Engine>,
+          dat_file_path),
       base::BindOnce(&AdBlockBaseService::OnGetDATFileData,
                      weak_factory_.GetWeakPtr()));
 }
 
 void AdBlockBaseService::OnGetDATFileData(GetDATFileDataResult result) {
-  if (result.second.empty()) {
-    LOG(ERROR) << "Could not obtain ad block data";
-    return;
-  }
-  if (!result.first.get()) {
-    LOG(ERROR) << "Failed to deserialize ad block data";
+  if (!result) {
+    LOG(ERROR) << "Could not load ad block data";
     return;
   }
   GetTaskRunner()->PostTask(
       FROM_HERE, base::BindOnce(&AdBlockBaseService::UpdateAdBlockClient,
-                                base::Unretained(this),
-                                std::move(result.first)));
+                                base::Unretained(this), std::move(result)));
 }
 
 void AdBlockBaseService::UpdateAdBlockClient(
     std::unique_ptr<adblock::Engine> ad_block_client) {
   DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
-  ad_block_client_ = std::move(ad_block_client);
+  std::swap(ad_block_client_, ad_block_client);
   AddKnownTagsToAdBlockInstance();
   AddKnownResourcesToAdBlockInstance();
+  OnEngineChanged();
+
+  // Tearing down a large engine can take a while, so do it off the sequence
+  // which matches requests
+  base::ThreadPool::PostTask(
+      FROM_HERE, {base::TaskPriority::BEST_EFFORT},
+      base::BindOnce([](std::unique_ptr<adblock::Engine> ad_block_client) {},
+                     std::move(ad_block_client)));
 }
 
 void AdBlockBaseService::AddKnownTagsToAdBlockInstance() {
@@ -271,6 +311,7 @@ void AdBlockBaseService::ResetForTest(const std::string& rules,
     resources_ = resources;
   }
   AddKnownResourcesToAdBlockInstance();
+  OnEngineChanged();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
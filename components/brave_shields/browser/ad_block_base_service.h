@@ -30,12 +30,29 @@ class Engine;
 
 namespace brave_shields {
 
+// The properties of a request which are shared by all adblock engines. These
+// are computed once per request rather than once for every engine which is
+// consulted.
+struct AdBlockRequestInfo {
+  AdBlockRequestInfo(const GURL& url,
+                     blink::mojom::ResourceType resource_type,
+                     const std::string& tab_host);
+  ~AdBlockRequestInfo();
+
+  std::string url_spec;
+  std::string host;
+  std::string tab_host;
+  bool is_third_party;
+  std::string resource_type;
+
+  DISALLOW_COPY_AND_ASSIGN(AdBlockRequestInfo);
+};
+
 // The base class of the brave shields service in charge of ad-block
 // checking and init.
 class AdBlockBaseService : public BaseBraveShieldsService {
  public:
-  using GetDATFileDataResult =
-      brave_component_updater::LoadDATFileDataResult<adblock::Engine>;
+  using GetDATFileDataResult = std::unique_ptr<adblock::Engine>;
 
   explicit AdBlockBaseService(BraveComponent::Delegate* delegate);
   ~AdBlockBaseService() override;
@@ -47,6 +64,11 @@ class AdBlockBaseService : public BaseBraveShieldsService {
                           bool* did_match_exception,
                           bool* did_match_important,
                           std::string* mock_data_url) override;
+  void ShouldStartRequest(const AdBlockRequestInfo& request_info,
+                          bool* did_match_rule,
+                          bool* did_match_exception,
+                          bool* did_match_important,
+                          std::string* mock_data_url);
   base::Optional<std::string> GetCspDirectives(
       const GURL& url,
       blink::mojom::ResourceType resource_type,
@@ -57,6 +79,14 @@ class AdBlockBaseService : public BaseBraveShieldsService {
 
   virtual base::Optional<base::Value> UrlCosmeticResources(
       const std::string& url);
+  // Returns whether generic cosmetic filtering is disabled for |url|
+  virtual bool UrlGenericHide(const std::string& url);
+
+  // Returns a number which changes whenever the rules, tags or resources of
+  // any adblock engine change, so that results derived from the engines can
+  // be cached.
+  static uint64_t GetEngineGeneration();
+  static void OnEngineChanged();
   virtual base::Optional<base::Value> HiddenClassIdSelectors(
       const std::vector<std::string>& classes,
       const std::vector<std::string>& ids,
@@ -116,9 +116,7 @@ bool AdBlockRegionalServiceManager::Start() {
 }
 
 void AdBlockRegionalServiceManager::ShouldStartRequest(
-    const GURL& url,
-    blink::mojom::ResourceType resource_type,
-    const std::string& tab_host,
+    const AdBlockRequestInfo& request_info,
     bool* did_match_rule,
     bool* did_match_exception,
     bool* did_match_important,
@@ -127,8 +125,8 @@ void AdBlockRegionalServiceManager::ShouldStartRequest(
 
   for (const auto& regional_service : regional_services_) {
     regional_service.second->ShouldStartRequest(
-        url, resource_type, tab_host, did_match_rule, did_match_exception,
-        did_match_important, mock_data_url);
+        request_info, did_match_rule, did_match_exception, did_match_important,
+        mock_data_url);
     if (did_match_important && *did_match_important) {
       return;
     }
@@ -192,6 +190,7 @@ void AdBlockRegionalServiceManager::EnableFilterList(
       regional_services_.erase(it);
     }
   }
+  AdBlockBaseService::OnEngineChanged();
 
   // Update preferences to reflect enabled/disabled state of specified
   // filter list
@@ -227,6 +226,17 @@ AdBlockRegionalServiceManager::UrlCosmeticResources(
   return first_value;
 }
 
+bool AdBlockRegionalServiceManager::UrlGenericHide(const std::string& url) {
+  base::AutoLock lock(regional_services_lock_);
+  for (const auto& regional_service : regional_services_) {
+    if (regional_service.second->UrlGenericHide(url)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
 base::Optional<base::Value>
 AdBlockRegionalServiceManager::HiddenClassIdSelectors(
         const std::vector<std::string>& classes,
@@ -32,6 +32,7 @@ using brave_component_updater::BraveComponent;
 namespace brave_shields {
 
 class AdBlockRegionalService;
+struct AdBlockRequestInfo;
 
 // The AdBlock regional service manager, in charge of initializing and
 // managing regional AdBlock clients.
@@ -47,9 +48,7 @@ class AdBlockRegionalServiceManager {
 
   bool IsInitialized() const;
   bool Start();
-  void ShouldStartRequest(const GURL& url,
-                          blink::mojom::ResourceType resource_type,
-                          const std::string& tab_host,
+  void ShouldStartRequest(const AdBlockRequestInfo& request_info,
                           bool* did_match_rule,
                           bool* did_match_exception,
                           bool* did_match_important,
@@ -64,6 +63,7 @@ class AdBlockRegionalServiceManager {
 
   base::Optional<base::Value> UrlCosmeticResources(
           const std::string& url);
+  bool UrlGenericHide(const std::string& url);
   base::Optional<base::Value> HiddenClassIdSelectors(
           const std::vector<std::string>& classes,
           const std::vector<std::string>& ids,
@@ -29,9 +29,12 @@
 #include "components/prefs/pref_registry_simple.h"
 #include "components/prefs/pref_service.h"
 #include "net/base/registry_controlled_domains/registry_controlled_domain.h"
+#include "url/gurl.h"
 
 #define DAT_FILE "rs-ABPFilterParserData.dat"
 #define REGIONAL_CATALOG "regional_catalog.json"
+#define HOST_COSMETIC_RESOURCES_CACHE_SIZE 100
+#define HIDDEN_CLASS_ID_SELECTORS_CACHE_SIZE 500
 
 namespace brave_shields {
 
@@ -70,23 +73,29 @@ void AdBlockService::ShouldStartRequest(
     bool* did_match_exception,
     bool* did_match_important,
     std::string* mock_data_url) {
-  AdBlockBaseService::ShouldStartRequest(
-      url, resource_type, tab_host, did_match_rule, did_match_exception,
-      did_match_important, mock_data_url);
+  const AdBlockRequestInfo request_info(url, resource_type, tab_host);
+
+  // The default, regional and custom engines are consulted one after another
+  // on the adblock sequence, which also owns their tags and resources. The
+  // adblock-rust engine is built with object pooling and must not be used
+  // from more than one thread at a time.
+  AdBlockBaseService::ShouldStartRequest(request_info, did_match_rule,
+                                         did_match_exception,
+                                         did_match_important, mock_data_url);
   if (did_match_important && *did_match_important) {
     return;
   }
 
   regional_service_manager()->ShouldStartRequest(
-      url, resource_type, tab_host, did_match_rule, did_match_exception,
-      did_match_important, mock_data_url);
+      request_info, did_match_rule, did_match_exception, did_match_important,
+      mock_data_url);
   if (did_match_important && *did_match_important) {
     return;
   }
 
   custom_filters_service()->ShouldStartRequest(
-      url, resource_type, tab_host, did_match_rule, did_match_exception,
-      did_match_important, mock_data_url);
+      request_info, did_match_rule, did_match_exception, did_match_important,
+      mock_data_url);
 }
 
 base::Optional<std::string> AdBlockService::GetCspDirectives(
@@ -109,6 +118,63 @@ base::Optional<std::string> AdBlockService::GetCspDirectives(
 
 base::Optional<base::Value> AdBlockService::UrlCosmeticResources(
     const std::string& url) {
+  DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
+  MaybeInvalidateCosmeticCaches();
+
+  // Selectors, exceptions and scriptlets only depend on the host, so they are
+  // shared by every page and frame of that host. Only the generichide flag
+  // can depend on the full URL, so it is checked for each URL
+  const std::string host = GURL(url).host();
+  auto iter = host_cosmetic_resources_cache_.Get(host);
+  if (iter == host_cosmetic_resources_cache_.end()) {
+    iter = host_cosmetic_resources_cache_.Put(host,
+                                              GetUrlCosmeticResources(url));
+  }
+
+  if (!iter->second) {
+    return base::nullopt;
+  }
+
+  base::Value resources = iter->second->Clone();
+  resources.SetBoolKey("generichide", GetUrlGenericHide(url));
+  return resources;
+}
+
+base::Optional<base::Value> AdBlockService::HiddenClassIdSelectors(
+    const std::vector<std::string>& classes,
+    const std::vector<std::string>& ids,
+    const std::vector<std::string>& exceptions) {
+  DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
+  MaybeInvalidateCosmeticCaches();
+
+  const HiddenClassIdSelectorsKey key =
+      std::make_tuple(classes, ids, exceptions);
+  auto iter = hidden_class_id_selectors_cache_.Get(key);
+  if (iter == hidden_class_id_selectors_cache_.end()) {
+    iter = hidden_class_id_selectors_cache_.Put(
+        key, GetHiddenClassIdSelectors(classes, ids, exceptions));
+  }
+
+  if (!iter->second) {
+    return base::nullopt;
+  }
+
+  return iter->second->Clone();
+}
+
+void AdBlockService::MaybeInvalidateCosmeticCaches() {
+  const uint64_t engine_generation = GetEngineGeneration();
+  if (engine_generation == cosmetic_caches_engine_generation_) {
+    return;
+  }
+
+  host_cosmetic_resources_cache_.Clear();
+  hidden_class_id_selectors_cache_.Clear();
+  cosmetic_caches_engine_generation_ = engine_generation;
+}
+
+base::Optional<base::Value> AdBlockService::GetUrlCosmeticResources(
+    const std::string& url) {
   base::Optional<base::Value> resources =
       AdBlockBaseService::UrlCosmeticResources(url);
 
@@ -135,7 +201,13 @@ base::Optional<base::Value> AdBlockService::UrlCosmeticResources(
   return resources;
 }
 
-base::Optional<base::Value> AdBlockService::HiddenClassIdSelectors(
+bool AdBlockService::GetUrlGenericHide(const std::string& url) {
+  return AdBlockBaseService::UrlGenericHide(url) ||
+         regional_service_manager()->UrlGenericHide(url) ||
+         custom_filters_service()->UrlGenericHide(url);
+}
+
+base::Optional<base::Value> AdBlockService::GetHiddenClassIdSelectors(
     const std::vector<std::string>& classes,
     const std::vector<std::string>& ids,
     const std::vector<std::string>& exceptions) {
@@ -203,7 +275,10 @@ AdBlockService::custom_filters_service() {
 
 AdBlockService::AdBlockService(
     brave_component_updater::BraveComponent::Delegate* delegate)
-    : AdBlockBaseService(delegate), component_delegate_(delegate) {}
+    : AdBlockBaseService(delegate),
+      host_cosmetic_resources_cache_(HOST_COSMETIC_RESOURCES_CACHE_SIZE),
+      hidden_class_id_selectors_cache_(HIDDEN_CLASS_ID_SELECTORS_CACHE_SIZE),
+      component_delegate_(delegate) {}
 
 AdBlockService::~AdBlockService() {}
 
@@ -10,8 +10,10 @@
 
 #include <memory>
 #include <string>
+#include <tuple>
 #include <vector>
 
+#include "base/containers/mru_cache.h"
 #include "base/optional.h"
 #include "base/values.h"
 #include "brave/components/brave_shields/browser/ad_block_base_service.h"
@@ -88,6 +90,32 @@ class AdBlockService : public AdBlockBaseService {
       const std::string& component_id,
       const std::string& component_base64_public_key);
 
+  using HiddenClassIdSelectorsKey = std::tuple<std::vector<std::string>,
+                                               std::vector<std::string>,
+                                               std::vector<std::string>>;
+
+  base::Optional<base::Value> GetUrlCosmeticResources(const std::string& url);
+  bool GetUrlGenericHide(const std::string& url);
+  base::Optional<base::Value> GetHiddenClassIdSelectors(
+      const std::vector<std::string>& classes,
+      const std::vector<std::string>& ids,
+      const std::vector<std::string>& exceptions);
+
+  // Clears the cosmetic filtering caches if any engine changed since they
+  // were populated
+  void MaybeInvalidateCosmeticCaches();
+
+  // Cosmetic filtering results are cached by host, and by batches of classes
+  // and ids, so that pages and frames of the same site and repeated DOM
+  // mutation scans do not query every engine again. Both caches belong to the
+  // engine generation in |cosmetic_caches_engine_generation_|. Only accessed
+  // on the task runner.
+  base::MRUCache<std::string, base::Optional<base::Value>>
+      host_cosmetic_resources_cache_;
+  base::MRUCache<HiddenClassIdSelectorsKey, base::Optional<base::Value>>
+      hidden_class_id_selectors_cache_;
+  uint64_t cosmetic_caches_engine_generation_ = 0;
+
   std::unique_ptr<brave_shields::AdBlockRegionalServiceManager>
       regional_service_manager_;
   std::unique_ptr<brave_shields::AdBlockCustomFiltersService>
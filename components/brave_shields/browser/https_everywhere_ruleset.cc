@@ -0,0 +1,193 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/https_everywhere_ruleset.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/json/json_reader.h"
+#include "base/memory/ptr_util.h"
+#include "base/values.h"
+#include "third_party/re2/src/re2/re2.h"
+#include "third_party/re2/src/re2/set.h"
+
+namespace brave_shields {
+
+namespace {
+
+struct Rule {
+  bool is_default = false;
+  std::unique_ptr<re2::RE2> from;
+  std::string to;
+};
+
+}  // namespace
+
+class HTTPSERuleset::Target {
+ public:
+  Target() : exclusions_(re2::RE2::Options(), re2::RE2::ANCHOR_BOTH) {}
+  ~Target() = default;
+
+  void AddExclusion(const std::string& pattern) {
+    if (exclusions_.Add(CorrectToRuleToRE2Engine(pattern), nullptr) != -1) {
+      has_exclusions_ = true;
+    }
+  }
+
+  void AddDefaultRule() {
+    Rule rule;
+    rule.is_default = true;
+    rules_.push_back(std::move(rule));
+  }
+
+  void AddRule(const std::string& from, const std::string& to) {
+    Rule rule;
+    rule.from = std::make_unique<re2::RE2>(from);
+    rule.to = CorrectToRuleToRE2Engine(to);
+    rules_.push_back(std::move(rule));
+  }
+
+  void set_terminates(const bool terminates) { terminates_ = terminates; }
+
+  void Compile() {
+    if (has_exclusions_ && !exclusions_.Compile()) {
+      has_exclusions_ = false;
+    }
+  }
+
+  // Returns true if no further targets should be applied to |url|, in which
+  // case |new_url| holds the result
+  bool Apply(const std::string& url, std::string* new_url) const {
+    if (has_exclusions_ && exclusions_.Match(url, nullptr)) {
+      *new_url = "";
+      return true;
+    }
+
+    if (terminates_) {
+      *new_url = "";
+      return true;
+    }
+
+    for (const auto& rule : rules_) {
+      if (rule.is_default) {
+        *new_url = url;
+        new_url->insert(4, "s");
+        return true;
+      }
+
+      std::string rewritten_url(url);
+      if (re2::RE2::Replace(&rewritten_url, *rule.from, rule.to) &&
+          rewritten_url != url) {
+        *new_url = rewritten_url;
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+ private:
+  re2::RE2::Set exclusions_;
+  bool has_exclusions_ = false;
+  bool terminates_ = false;
+  std::vector<Rule> rules_;
+
+  DISALLOW_COPY_AND_ASSIGN(Target);
+};
+
+HTTPSERuleset::HTTPSERuleset() = default;
+
+HTTPSERuleset::~HTTPSERuleset() = default;
+
+// static
+std::unique_ptr<HTTPSERuleset> HTTPSERuleset::Parse(const std::string& json) {
+  base::Optional<base::Value> json_object = base::JSONReader::Read(json);
+  if (!json_object || !json_object->is_list()) {
+    return nullptr;
+  }
+
+  auto ruleset = base::WrapUnique(new HTTPSERuleset());
+
+  for (const auto& target_value : json_object->GetList()) {
+    if (!target_value.is_dict()) {
+      continue;
+    }
+
+    auto target = std::make_unique<Target>();
+
+    const base::Value* exclusions = target_value.FindListKey("e");
+    if (exclusions) {
+      for (const auto& exclusion : exclusions->GetList()) {
+        if (!exclusion.is_dict()) {
+          continue;
+        }
+
+        const std::string* pattern = exclusion.FindStringKey("p");
+        if (!pattern) {
+          continue;
+        }
+
+        target->AddExclusion(*pattern);
+      }
+    }
+
+    const base::Value* rules = target_value.FindListKey("r");
+    if (!rules) {
+      // Targets without rules stop any further targets from being applied
+      target->set_terminates(true);
+      target->Compile();
+      ruleset->targets_.push_back(std::move(target));
+      break;
+    }
+
+    for (const auto& rule : rules->GetList()) {
+      if (!rule.is_dict()) {
+        continue;
+      }
+
+      if (rule.FindKey("d")) {
+        target->AddDefaultRule();
+        continue;
+      }
+
+      const std::string* from = rule.FindStringKey("f");
+      const std::string* to = rule.FindStringKey("t");
+      if (!from || !to) {
+        continue;
+      }
+
+      target->AddRule(*from, *to);
+    }
+
+    target->Compile();
+    ruleset->targets_.push_back(std::move(target));
+  }
+
+  return ruleset;
+}
+
+std::string HTTPSERuleset::Apply(const std::string& url) const {
+  std::string new_url;
+  for (const auto& target : targets_) {
+    if (target->Apply(url, &new_url)) {
+      return new_url;
+    }
+  }
+
+  return "";
+}
+
+// static
+std::string HTTPSERuleset::CorrectToRuleToRE2Engine(const std::string& to) {
+  std::string corrected_to(to);
+  std::replace(corrected_to.begin(), corrected_to.end(), '$', '\\');
+  return corrected_to;
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,51 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RULESET_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RULESET_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/macros.h"
+
+namespace re2 {
+class RE2;
+}  // namespace re2
+
+namespace brave_shields {
+
+// A HTTPS Everywhere ruleset which has been parsed once from the JSON stored
+// in the rules database. Regular expressions are compiled when the ruleset is
+// parsed and kept for the lifetime of the ruleset, and the exclusions of each
+// target are matched with a single RE2::Set, so applying the ruleset to a URL
+// does not parse JSON or construct regular expressions.
+class HTTPSERuleset {
+ public:
+  ~HTTPSERuleset();
+
+  // Returns nullptr if |json| is not a list of rules
+  static std::unique_ptr<HTTPSERuleset> Parse(const std::string& json);
+
+  // Returns the rewritten URL or an empty string if no rule applies
+  std::string Apply(const std::string& url) const;
+
+  // Replaces '$' backreferences with the '\' syntax used by RE2
+  static std::string CorrectToRuleToRE2Engine(const std::string& to);
+
+ private:
+  class Target;
+
+  HTTPSERuleset();
+
+  std::vector<std::unique_ptr<Target>> targets_;
+
+  DISALLOW_COPY_AND_ASSIGN(HTTPSERuleset);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RULESET_H_
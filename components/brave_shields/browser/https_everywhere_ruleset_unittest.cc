@@ -0,0 +1,66 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <memory>
+#include <string>
+
+#include "brave/components/brave_shields/browser/https_everywhere_ruleset.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+using brave_shields::HTTPSERuleset;
+
+TEST(HTTPSEverywhereRulesetTest, InvalidJson) {
+  EXPECT_FALSE(HTTPSERuleset::Parse("not json"));
+  EXPECT_FALSE(HTTPSERuleset::Parse("{}"));
+}
+
+TEST(HTTPSEverywhereRulesetTest, DefaultRule) {
+  std::unique_ptr<HTTPSERuleset> ruleset =
+      HTTPSERuleset::Parse(R"([{"r":[{"d":1}]}])");
+  ASSERT_TRUE(ruleset);
+
+  EXPECT_EQ("https://example.com/", ruleset->Apply("http://example.com/"));
+}
+
+TEST(HTTPSEverywhereRulesetTest, RewriteRule) {
+  std::unique_ptr<HTTPSERuleset> ruleset = HTTPSERuleset::Parse(
+      R"([{"r":[{"f":"^http://(www\\.)?example\\.com/",)"
+      R"("t":"https://$1example.com/"}]}])");
+  ASSERT_TRUE(ruleset);
+
+  EXPECT_EQ("https://www.example.com/path",
+            ruleset->Apply("http://www.example.com/path"));
+  EXPECT_EQ("", ruleset->Apply("http://example.org/"));
+
+  // Compiled rules are reused when the ruleset is applied again
+  EXPECT_EQ("https://example.com/", ruleset->Apply("http://example.com/"));
+}
+
+TEST(HTTPSEverywhereRulesetTest, Exclusion) {
+  std::unique_ptr<HTTPSERuleset> ruleset = HTTPSERuleset::Parse(
+      R"([{"e":[{"p":"^http://example\\.com/insecure/.*"}],"r":[{"d":1}]}])");
+  ASSERT_TRUE(ruleset);
+
+  EXPECT_EQ("", ruleset->Apply("http://example.com/insecure/page"));
+  EXPECT_EQ("https://example.com/secure/page",
+            ruleset->Apply("http://example.com/secure/page"));
+}
+
+TEST(HTTPSEverywhereRulesetTest, TargetWithoutRulesStopsMatching) {
+  std::unique_ptr<HTTPSERuleset> ruleset =
+      HTTPSERuleset::Parse(R"([{"e":[]},{"r":[{"d":1}]}])");
+  ASSERT_TRUE(ruleset);
+
+  EXPECT_EQ("", ruleset->Apply("http://example.com/"));
+}
+
+TEST(HTTPSEverywhereRulesetTest, FallsThroughToNextTarget) {
+  std::unique_ptr<HTTPSERuleset> ruleset = HTTPSERuleset::Parse(
+      R"([{"r":[{"f":"^http://foo\\.com/","t":"https://foo.com/"}]},)"
+      R"({"r":[{"d":1}]}])");
+  ASSERT_TRUE(ruleset);
+
+  EXPECT_EQ("https://bar.com/", ruleset->Apply("http://bar.com/"));
+}
@@ -10,12 +10,14 @@
 #include <string>
 #include <vector>
 
+#include "base/containers/mru_cache.h"
 #include "base/files/file_path.h"
 #include "base/memory/weak_ptr.h"
 #include "base/sequence_checker.h"
 #include "base/synchronization/lock.h"
 #include "brave/components/brave_shields/browser/base_brave_shields_service.h"
 #include "brave/components/brave_shields/browser/https_everywhere_recently_used_cache.h"
+#include "brave/components/brave_shields/browser/https_everywhere_ruleset.h"
 
 namespace leveldb {
 class DB;
@@ -63,9 +65,9 @@ class HTTPSEverywhereService : public BaseBraveShieldsService,
 
   void AddHTTPSEUrlToRedirectList(const uint64_t& request_id);
   bool ShouldHTTPSERedirect(const uint64_t& request_id);
-  std::string ApplyHTTPSRule(const std::string& originalUrl,
-      const std::string& rule);
-  std::string CorrecttoRuleToRE2Engine(const std::string& to);
+  // Returns the compiled ruleset for |domain| or nullptr if there are no
+  // rules for the domain
+  const HTTPSERuleset* GetRuleset(const std::string& domain);
 
  private:
   friend class ::HTTPSEverywhereServiceTest;
@@ -84,6 +86,7 @@ class HTTPSEverywhereService : public BaseBraveShieldsService,
   base::Lock httpse_get_urls_redirects_count_mutex_;
   std::vector<HTTPSE_REDIRECTS_COUNT_ST> httpse_urls_redirects_count_;
   HTTPSERecentlyUsedCache<std::string> recently_used_cache_;
+  base::MRUCache<std::string, std::unique_ptr<HTTPSERuleset>> rulesets_;
   leveldb::DB* level_db_;
 
   SEQUENCE_CHECKER(sequence_checker_);
@@ -5,45 +5,60 @@
 
 #include "brave/components/brave_shields/common/brave_shield_utils.h"
 
-#include "base/optional.h"
+#include "base/bind.h"
 #include "components/content_settings/core/common/content_settings_pattern.h"
 #include "url/gurl.h"
 
+namespace {
+
+bool IsFPRuleForSecondaryPattern(
+    const ContentSettingsPattern& balanced_pattern,
+    const ContentSettingPatternSource& rule) {
+  return rule.secondary_pattern == balanced_pattern ||
+         rule.secondary_pattern == ContentSettingsPattern::Wildcard();
+}
+
+bool IsSiteFPRule(const ContentSettingsPattern& balanced_pattern,
+                  const ContentSettingPatternSource& rule) {
+  return rule.primary_pattern != ContentSettingsPattern::Wildcard() &&
+         IsFPRuleForSecondaryPattern(balanced_pattern, rule);
+}
+
+bool IsGlobalFPRule(const ContentSettingsPattern& balanced_pattern,
+                    const ContentSettingPatternSource& rule) {
+  return rule.primary_pattern == ContentSettingsPattern::Wildcard() &&
+         IsFPRuleForSecondaryPattern(balanced_pattern, rule);
+}
+
+}  // namespace
+
 ContentSetting GetBraveFPContentSettingFromRules(
     const ContentSettingsForOneType& fp_rules,
     const GURL& primary_url) {
-  base::Optional<ContentSettingPatternSource> global_fp_rule;
-  base::Optional<ContentSettingPatternSource> global_fp_balanced_rule;
-
-  for (const auto& rule : fp_rules) {
-    if (rule.primary_pattern != ContentSettingsPattern::Wildcard() &&
-        rule.primary_pattern.Matches(primary_url)) {
-      if (rule.secondary_pattern ==
-          ContentSettingsPattern::FromString("https://balanced")) {
-        return CONTENT_SETTING_DEFAULT;
-      }
-      if (rule.secondary_pattern == ContentSettingsPattern::Wildcard())
-        return rule.GetContentSetting();
-    }
-
-    if (rule.primary_pattern == ContentSettingsPattern::Wildcard()) {
-      if (rule.secondary_pattern ==
-          ContentSettingsPattern::FromString("https://balanced")) {
-        DCHECK(!global_fp_rule);
-        global_fp_balanced_rule = rule;
-      }
-      if (rule.secondary_pattern == ContentSettingsPattern::Wildcard()) {
-        DCHECK(!global_fp_balanced_rule);
-        global_fp_rule = rule;
-      }
-    }
+  return GetBraveFPContentSettingFromRules(
+      fp_rules, content_settings::BuildRulesIndex(fp_rules), primary_url);
+}
+
+ContentSetting GetBraveFPContentSettingFromRules(
+    const ContentSettingsForOneType& fp_rules,
+    const content_settings::RulesIndex& fp_rules_index,
+    const GURL& primary_url) {
+  const ContentSettingsPattern balanced_pattern =
+      ContentSettingsPattern::FromString("https://balanced");
+
+  // Site rules take precedence over the global rule
+  const ContentSettingPatternSource* rule = content_settings::FindMatchingRule(
+      fp_rules, fp_rules_index, primary_url,
+      base::BindRepeating(&IsSiteFPRule, balanced_pattern));
+  if (!rule) {
+    rule = content_settings::FindMatchingRule(
+        fp_rules, fp_rules_index, primary_url,
+        base::BindRepeating(&IsGlobalFPRule, balanced_pattern));
   }
 
-  if (global_fp_balanced_rule)
+  if (!rule || rule->secondary_pattern == balanced_pattern) {
     return CONTENT_SETTING_DEFAULT;
+  }
 
-  if (global_fp_rule)
-    return global_fp_rule->GetContentSetting();
-
-  return CONTENT_SETTING_DEFAULT;
+  return rule->GetContentSetting();
 }
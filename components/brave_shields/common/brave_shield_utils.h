@@ -14,4 +14,11 @@ ContentSetting GetBraveFPContentSettingFromRules(
     const ContentSettingsForOneType& fp_rules,
     const GURL& primary_url);
 
+// Same as above, but only checks the rules that can match |primary_url| using
+// |fp_rules_index|, which must have been built for |fp_rules|.
+ContentSetting GetBraveFPContentSettingFromRules(
+    const ContentSettingsForOneType& fp_rules,
+    const content_settings::RulesIndex& fp_rules_index,
+    const GURL& primary_url);
+
 #endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_COMMON_BRAVE_SHIELD_UTILS_H_
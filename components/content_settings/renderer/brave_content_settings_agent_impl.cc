@@ -52,21 +52,26 @@ GURL GetOriginOrURL(const blink::WebFrame* frame) {
   return top_origin.GetURL();
 }
 
-bool IsBraveShieldsDown(const blink::WebFrame* frame,
-                        const GURL& secondary_url,
-                        const ContentSettingsForOneType& rules) {
-  ContentSetting setting = CONTENT_SETTING_DEFAULT;
-  const GURL& primary_url = GetOriginOrURL(frame);
-
-  for (const auto& rule : rules) {
-    if (rule.primary_pattern.Matches(primary_url) &&
-        rule.secondary_pattern.Matches(secondary_url)) {
-      setting = rule.GetContentSetting();
-      break;
-    }
+ContentSetting GetContentSettingFromIndexedRules(
+    const ContentSettingsForOneType& rules,
+    const RulesIndex& index,
+    const blink::WebFrame* frame,
+    const GURL& secondary_url) {
+  const ContentSettingPatternSource* rule =
+      FindMatchingRule(rules, index, GetOriginOrURL(frame), secondary_url);
+  if (!rule) {
+    return CONTENT_SETTING_DEFAULT;
   }
 
-  return setting == CONTENT_SETTING_BLOCK;
+  return rule->GetContentSetting();
+}
+
+bool IsBraveShieldsDown(const blink::WebFrame* frame,
+                        const GURL& secondary_url,
+                        const RendererContentSettingRules& rules) {
+  return GetContentSettingFromIndexedRules(
+             rules.brave_shields_rules, rules.brave_shields_rules_index,
+             frame, secondary_url) == CONTENT_SETTING_BLOCK;
 }
 
 }  // namespace
@@ -237,8 +242,8 @@ bool BraveContentSettingsAgentImpl::IsBraveShieldsDown(
     const blink::WebFrame* frame,
     const GURL& secondary_url) {
   return !content_setting_rules_ ||
-         ::content_settings::IsBraveShieldsDown(
-             frame, secondary_url, content_setting_rules_->brave_shields_rules);
+         ::content_settings::IsBraveShieldsDown(frame, secondary_url,
+                                                *content_setting_rules_);
 }
 
 bool BraveContentSettingsAgentImpl::AllowFingerprinting(
@@ -264,7 +269,9 @@ BraveFarblingLevel BraveContentSettingsAgentImpl::GetBraveFarblingLevel() {
       setting = CONTENT_SETTING_ALLOW;
     } else {
       setting = GetBraveFPContentSettingFromRules(
-          content_setting_rules_->fingerprinting_rules, GetOriginOrURL(frame));
+          content_setting_rules_->fingerprinting_rules,
+          content_setting_rules_->fingerprinting_rules_index,
+          GetOriginOrURL(frame));
     }
   }
 
@@ -291,9 +298,10 @@ bool BraveContentSettingsAgentImpl::AllowAutoplay(bool play_requested) {
 
   // respect user's site blocklist, if any
   if (content_setting_rules_) {
-    ContentSetting setting =
-        GetContentSettingFromRules(content_setting_rules_->autoplay_rules,
-                                   frame, url::Origin(origin).GetURL());
+    ContentSetting setting = GetContentSettingFromIndexedRules(
+        content_setting_rules_->autoplay_rules,
+        content_setting_rules_->autoplay_rules_index, frame,
+        url::Origin(origin).GetURL());
     if (setting == CONTENT_SETTING_BLOCK) {
       VLOG(1) << "AllowAutoplay=false because rule=CONTENT_SETTING_BLOCK";
       if (play_requested)
@@ -117,6 +117,8 @@ TEST_F(BraveContentSettingsAgentImplAutoplayBrowserTest,
           content_settings::ContentSettingToValue(CONTENT_SETTING_BLOCK)),
       std::string(), false));
 
+  content_settings::BuildRulesIndexes(&content_setting_rules);
+
   MockContentSettingsAgentImpl agent(view_->GetMainRenderFrame());
   agent.SetContentSettingRules(&content_setting_rules);
   EXPECT_FALSE(agent.AllowAutoplay(true));
@@ -133,6 +135,7 @@ TEST_F(BraveContentSettingsAgentImplAutoplayBrowserTest,
           base::Value::FromUniquePtrValue(
               content_settings::ContentSettingToValue(CONTENT_SETTING_ALLOW)),
           std::string(), false));
+  content_settings::BuildRulesIndexes(&content_setting_rules);
   EXPECT_TRUE(agent.AllowAutoplay(true));
 }
 
@@ -150,6 +153,8 @@ TEST_F(BraveContentSettingsAgentImplAutoplayBrowserTest,
           content_settings::ContentSettingToValue(CONTENT_SETTING_ALLOW)),
       std::string(), false));
 
+  content_settings::BuildRulesIndexes(&content_setting_rules);
+
   MockContentSettingsAgentImpl agent(view_->GetMainRenderFrame());
   agent.SetContentSettingRules(&content_setting_rules);
   EXPECT_TRUE(agent.AllowAutoplay(true));
@@ -163,6 +168,7 @@ TEST_F(BraveContentSettingsAgentImplAutoplayBrowserTest,
           base::Value::FromUniquePtrValue(
               content_settings::ContentSettingToValue(CONTENT_SETTING_BLOCK)),
           std::string(), false));
+  content_settings::BuildRulesIndexes(&content_setting_rules);
   EXPECT_FALSE(agent.AllowAutoplay(true));
   base::RunLoop().RunUntilIdle();
   EXPECT_EQ(1, agent.on_content_blocked_count());
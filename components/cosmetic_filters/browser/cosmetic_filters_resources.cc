@@ -5,7 +5,9 @@
 
 #include "brave/components/cosmetic_filters/browser/cosmetic_filters_resources.h"
 
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "base/json/json_reader.h"
 #include "base/optional.h"
@@ -16,6 +18,69 @@
 
 namespace cosmetic_filters {
 
+namespace {
+
+std::vector<std::string> GetStringList(const base::Value& resources,
+                                       const char* key) {
+  std::vector<std::string> strings;
+  const base::Value* list = resources.FindListKey(key);
+  if (!list) {
+    return strings;
+  }
+
+  strings.reserve(list->GetList().size());
+  for (const auto& item : list->GetList()) {
+    if (item.is_string()) {
+      strings.push_back(item.GetString());
+    }
+  }
+
+  return strings;
+}
+
+// Converts the resources merged by the adblock service into a typed struct,
+// so the renderer does not need to walk a generic value
+mojom::UrlCosmeticResourcesPtr ToMojom(const base::Value& resources) {
+  auto result = mojom::UrlCosmeticResources::New();
+  result->hide_selectors = GetStringList(resources, "hide_selectors");
+  result->force_hide_selectors =
+      GetStringList(resources, "force_hide_selectors");
+  result->exceptions = GetStringList(resources, "exceptions");
+
+  const base::Value* style_selectors =
+      resources.FindDictKey("style_selectors");
+  if (style_selectors) {
+    for (const auto& item : style_selectors->DictItems()) {
+      result->style_selectors[item.first] =
+          GetStringList(*style_selectors, item.first.c_str());
+    }
+  }
+
+  const std::string* injected_script =
+      resources.FindStringKey("injected_script");
+  if (injected_script) {
+    result->injected_script = *injected_script;
+  }
+
+  result->generichide = resources.FindBoolKey("generichide").value_or(false);
+
+  return result;
+}
+
+mojom::UrlCosmeticResourcesPtr GetUrlCosmeticResourcesOnTaskRunner(
+    brave_shields::AdBlockService* ad_block_service,
+    const std::string& url) {
+  base::Optional<base::Value> resources =
+      ad_block_service->UrlCosmeticResources(url);
+  if (!resources || !resources->is_dict()) {
+    return nullptr;
+  }
+
+  return ToMojom(*resources);
+}
+
+}  // namespace
+
 CosmeticFiltersResources::CosmeticFiltersResources(
     HostContentSettingsMap* settings_map,
     brave_shields::AdBlockService* ad_block_service)
@@ -81,31 +146,32 @@ void CosmeticFiltersResources::HiddenClassIdSelectorsOnUI(
 
 void CosmeticFiltersResources::UrlCosmeticResourcesOnUI(
     UrlCosmeticResourcesCallback callback,
-    base::Optional<base::Value> resources) {
-  std::move(callback).Run(resources ? std::move(resources.value())
-                                    : base::Value());
-}
-
-void CosmeticFiltersResources::ShouldDoCosmeticFiltering(
-    const std::string& url,
-    ShouldDoCosmeticFilteringCallback callback) {
-  bool enabled =
-      brave_shields::ShouldDoCosmeticFiltering(settings_map_, GURL(url));
-  bool first_party_enabled =
-      brave_shields::IsFirstPartyCosmeticFilteringEnabled(settings_map_,
-                                                          GURL(url));
-  std::move(callback).Run(enabled, first_party_enabled);
+    bool first_party_enabled,
+    mojom::UrlCosmeticResourcesPtr resources) {
+  std::move(callback).Run(/* enabled */ true, first_party_enabled,
+                          std::move(resources));
 }
 
 void CosmeticFiltersResources::UrlCosmeticResources(
     const std::string& url,
     UrlCosmeticResourcesCallback callback) {
+  const GURL gurl(url);
+  if (!brave_shields::ShouldDoCosmeticFiltering(settings_map_, gurl)) {
+    std::move(callback).Run(/* enabled */ false,
+                            /* first_party_enabled */ false, nullptr);
+    return;
+  }
+
+  const bool first_party_enabled =
+      brave_shields::IsFirstPartyCosmeticFilteringEnabled(settings_map_, gurl);
+
   ad_block_service_->GetTaskRunner()->PostTaskAndReplyWithResult(
       FROM_HERE,
-      base::BindOnce(&brave_shields::AdBlockService::UrlCosmeticResources,
+      base::BindOnce(&GetUrlCosmeticResourcesOnTaskRunner,
                      base::Unretained(ad_block_service_), url),
       base::BindOnce(&CosmeticFiltersResources::UrlCosmeticResourcesOnUI,
-                     weak_factory_.GetWeakPtr(), std::move(callback)));
+                     weak_factory_.GetWeakPtr(), std::move(callback),
+                     first_party_enabled));
 }
 
 }  // namespace cosmetic_filters
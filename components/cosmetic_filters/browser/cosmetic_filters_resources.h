@@ -35,20 +35,14 @@ class CosmeticFiltersResources final
                            brave_shields::AdBlockService* ad_block_service);
   ~CosmeticFiltersResources() override;
 
-  // Sends back to renderer a response: do we need to apply cosmetic filters
-  // for the url.
-  void ShouldDoCosmeticFiltering(
-      const std::string& url,
-      ShouldDoCosmeticFilteringCallback callback) override;
-
   // Sends back to renderer a response about rules that has to be applied
   // for the specified selectors.
   void HiddenClassIdSelectors(const std::string& input,
                               const std::vector<std::string>& exceptions,
                               HiddenClassIdSelectorsCallback callback) override;
 
-  // Sends back to renderer a response what rules and scripts has to be
-  // applied for the specified url.
+  // Sends back to renderer a response: do we need to apply cosmetic filters
+  // for the url, and if so what rules and scripts has to be applied.
   void UrlCosmeticResources(const std::string& url,
                             UrlCosmeticResourcesCallback callback) override;
 
@@ -57,7 +51,8 @@ class CosmeticFiltersResources final
                                   base::Optional<base::Value> resources);
 
   void UrlCosmeticResourcesOnUI(UrlCosmeticResourcesCallback callback,
-                                base::Optional<base::Value> resources);
+                                bool first_party_enabled,
+                                mojom::UrlCosmeticResourcesPtr resources);
 
   HostContentSettingsMap* settings_map_;             // Not owned
   brave_shields::AdBlockService* ad_block_service_;  // Not owned
@@ -8,7 +8,9 @@
 #include <utility>
 
 #include "base/bind.h"
+#include "base/containers/flat_map.h"
 #include "base/json/json_writer.h"
+#include "base/json/string_escape.h"
 #include "base/no_destructor.h"
 #include "base/strings/stringprintf.h"
 #include "base/strings/utf_string_conversions.h"
@@ -162,6 +164,37 @@ std::string LoadDataResource(const int id) {
   return resource_bundle.GetRawDataResource(id).as_string();
 }
 
+// Serializes |strings| as a JavaScript array literal without building an
+// intermediate value
+std::string ToJSONArray(const std::vector<std::string>& strings) {
+  std::string json = "[";
+  for (size_t i = 0; i < strings.size(); i++) {
+    if (i != 0) {
+      json += ",";
+    }
+    base::EscapeJSONString(strings[i], /* put_in_quotes */ true, &json);
+  }
+  json += "]";
+  return json;
+}
+
+std::string ToJSONObject(
+    const base::flat_map<std::string, std::vector<std::string>>& map) {
+  std::string json = "{";
+  bool is_first = true;
+  for (const auto& item : map) {
+    if (!is_first) {
+      json += ",";
+    }
+    is_first = false;
+    base::EscapeJSONString(item.first, /* put_in_quotes */ true, &json);
+    json += ":";
+    json += ToJSONArray(item.second);
+  }
+  json += "}";
+  return json;
+}
+
 bool IsVettedSearchEngine(const GURL& url) {
   std::string domain_and_registry =
       net::registry_controlled_domains::GetDomainAndRegistry(
@@ -276,51 +309,43 @@ bool CosmeticFiltersJSHandler::EnsureConnected() {
 
 void CosmeticFiltersJSHandler::ProcessURL(const GURL& url,
                                           base::OnceClosure callback) {
-  resources_dict_.reset();
+  resources_.reset();
   url_ = url;
   // Trivially, don't make exceptions for malformed URLs.
   if (!EnsureConnected() || url_.is_empty() || !url_.is_valid())
     return;
 
-  cosmetic_filters_resources_->ShouldDoCosmeticFiltering(
+  cosmetic_filters_resources_->UrlCosmeticResources(
       url_.spec(),
-      base::BindOnce(&CosmeticFiltersJSHandler::OnShouldDoCosmeticFiltering,
+      base::BindOnce(&CosmeticFiltersJSHandler::OnUrlCosmeticResources,
                      base::Unretained(this), std::move(callback)));
 }
 
-void CosmeticFiltersJSHandler::OnShouldDoCosmeticFiltering(
+void CosmeticFiltersJSHandler::OnUrlCosmeticResources(
     base::OnceClosure callback,
     bool enabled,
-    bool first_party_enabled) {
-  if (!enabled || !EnsureConnected())
+    bool first_party_enabled,
+    mojom::UrlCosmeticResourcesPtr result) {
+  if (!enabled)
     return;
 
   enabled_1st_party_cf_ = first_party_enabled;
-  cosmetic_filters_resources_->UrlCosmeticResources(
-      url_.spec(),
-      base::BindOnce(&CosmeticFiltersJSHandler::OnUrlCosmeticResources,
-                     base::Unretained(this), std::move(callback)));
-}
-
-void CosmeticFiltersJSHandler::OnUrlCosmeticResources(
-    base::OnceClosure callback,
-    base::Value result) {
-  resources_dict_ = base::DictionaryValue::From(
-      base::Value::ToUniquePtrValue(std::move(result)));
+  resources_ = std::move(result);
   std::move(callback).Run();
 }
 
 void CosmeticFiltersJSHandler::ApplyRules() {
   blink::WebLocalFrame* web_frame = render_frame_->GetWebFrame();
-  if (!resources_dict_ || web_frame->IsProvisional())
+  if (!resources_ || web_frame->IsProvisional())
     return;
 
   std::string scriptlet_script;
-  base::Value* injected_script = resources_dict_->FindPath("injected_script");
-  if (injected_script &&
-      base::JSONWriter::Write(*injected_script, &scriptlet_script)) {
+  if (!resources_->injected_script.empty()) {
+    std::string injected_script;
+    base::EscapeJSONString(resources_->injected_script,
+                           /* put_in_quotes */ true, &injected_script);
     scriptlet_script =
-        base::StringPrintf(kScriptletInitScript, scriptlet_script.c_str());
+        base::StringPrintf(kScriptletInitScript, injected_script.c_str());
   }
   if (!scriptlet_script.empty()) {
     web_frame->ExecuteScriptInIsolatedWorld(
@@ -330,11 +355,9 @@ void CosmeticFiltersJSHandler::ApplyRules() {
     return;
 
   // Working on css rules, we do that on a main frame only
-  bool generichide = false;
-  resources_dict_->GetBoolean("generichide", &generichide);
   std::string cosmetic_filtering_init_script = base::StringPrintf(
       kCosmeticFilteringInitScript, enabled_1st_party_cf_ ? "true" : "false",
-      generichide ? "true" : "false");
+      resources_->generichide ? "true" : "false");
   std::string pre_init_script = base::StringPrintf(
       kPreInitScript, cosmetic_filtering_init_script.c_str());
 
@@ -343,74 +366,44 @@ void CosmeticFiltersJSHandler::ApplyRules() {
   web_frame->ExecuteScriptInIsolatedWorld(
       isolated_world_id_, blink::WebString::FromUTF8(*g_observing_script));
 
-  CSSRulesRoutine(resources_dict_.get());
+  CSSRulesRoutine(*resources_);
 }
 
 void CosmeticFiltersJSHandler::CSSRulesRoutine(
-    base::DictionaryValue* resources_dict) {
+    const mojom::UrlCosmeticResources& resources) {
   // Otherwise, if its a vetted engine AND we're not in aggressive
   // mode, also don't do cosmetic filtering.
   if (!enabled_1st_party_cf_ && IsVettedSearchEngine(url_))
     return;
 
   blink::WebLocalFrame* web_frame = render_frame_->GetWebFrame();
-  base::ListValue* cf_exceptions_list;
-  if (resources_dict->GetList("exceptions", &cf_exceptions_list)) {
-    for (size_t i = 0; i < cf_exceptions_list->GetSize(); i++) {
-      exceptions_.push_back(cf_exceptions_list->GetList()[i].GetString());
-    }
-  }
-  base::ListValue* hide_selectors_list;
-  if (!resources_dict->GetList("hide_selectors", &hide_selectors_list)) {
-    hide_selectors_list = nullptr;
-  }
-  base::ListValue* force_hide_selectors_list;
-  if (!resources_dict->GetList("force_hide_selectors",
-                               &force_hide_selectors_list)) {
-    force_hide_selectors_list = nullptr;
-  }
+  exceptions_.insert(exceptions_.end(), resources.exceptions.begin(),
+                     resources.exceptions.end());
 
-  if (hide_selectors_list && hide_selectors_list->GetSize() != 0) {
-    std::string json_selectors;
-    if (!base::JSONWriter::Write(*hide_selectors_list, &json_selectors) ||
-        json_selectors.empty()) {
-      json_selectors = "[]";
-    }
+  if (!resources.hide_selectors.empty()) {
     // Building a script for stylesheet modifications
     std::string new_selectors_script =
-        base::StringPrintf(kHideSelectorsInjectScript, json_selectors.c_str());
+        base::StringPrintf(kHideSelectorsInjectScript,
+                           ToJSONArray(resources.hide_selectors).c_str());
     web_frame->ExecuteScriptInIsolatedWorld(
         isolated_world_id_, blink::WebString::FromUTF8(new_selectors_script));
   }
 
-  if (force_hide_selectors_list && force_hide_selectors_list->GetSize() != 0) {
-    std::string json_selectors;
-    if (!base::JSONWriter::Write(*force_hide_selectors_list, &json_selectors) ||
-        json_selectors.empty()) {
-      json_selectors = "[]";
-    }
+  if (!resources.force_hide_selectors.empty()) {
     // Building a script for stylesheet modifications
-    std::string new_selectors_script = base::StringPrintf(
-        kForceHideSelectorsInjectScript, json_selectors.c_str());
+    std::string new_selectors_script =
+        base::StringPrintf(kForceHideSelectorsInjectScript,
+                           ToJSONArray(resources.force_hide_selectors).c_str());
     web_frame->ExecuteScriptInIsolatedWorld(
         isolated_world_id_, blink::WebString::FromUTF8(new_selectors_script));
   }
 
-  base::DictionaryValue* style_selectors_dictionary = nullptr;
-  if (resources_dict->GetDictionary("style_selectors",
-                                    &style_selectors_dictionary)) {
-    std::string json_selectors;
-    if (!base::JSONWriter::Write(*style_selectors_dictionary,
-                                 &json_selectors) ||
-        json_selectors.empty()) {
-      json_selectors = "[]";
-    }
+  if (!resources.style_selectors.empty()) {
     std::string new_selectors_script =
-        base::StringPrintf(kStyleSelectorsInjectScript, json_selectors.c_str());
-    if (!json_selectors.empty()) {
-      web_frame->ExecuteScriptInIsolatedWorld(
-          isolated_world_id_, blink::WebString::FromUTF8(new_selectors_script));
-    }
+        base::StringPrintf(kStyleSelectorsInjectScript,
+                           ToJSONObject(resources.style_selectors).c_str());
+    web_frame->ExecuteScriptInIsolatedWorld(
+        isolated_world_id_, blink::WebString::FromUTF8(new_selectors_script));
   }
 
   if (!enabled_1st_party_cf_) {
@@ -52,11 +52,11 @@ class CosmeticFiltersJSHandler {
   // A function to be called from JS
   void HiddenClassIdSelectors(const std::string& input);
 
-  void OnShouldDoCosmeticFiltering(base::OnceClosure callback,
-                                   bool enabled,
-                                   bool first_party_enabled);
-  void OnUrlCosmeticResources(base::OnceClosure callback, base::Value result);
-  void CSSRulesRoutine(base::DictionaryValue* resources_dict);
+  void OnUrlCosmeticResources(base::OnceClosure callback,
+                              bool enabled,
+                              bool first_party_enabled,
+                              mojom::UrlCosmeticResourcesPtr result);
+  void CSSRulesRoutine(const mojom::UrlCosmeticResources& resources);
   void OnHiddenClassIdSelectors(base::Value result);
 
   content::RenderFrame* render_frame_;
@@ -66,7 +66,7 @@ class CosmeticFiltersJSHandler {
   bool enabled_1st_party_cf_;
   std::vector<std::string> exceptions_;
   GURL url_;
-  std::unique_ptr<base::DictionaryValue> resources_dict_;
+  mojom::UrlCosmeticResourcesPtr resources_;
 };
 
 // static
@@ -10,6 +10,8 @@
 #include "mojo/public/cpp/bindings/interface_request.h"
 #include "mojo/public/cpp/bindings/sync_call_restrictions.h"
 #include "base/logging.h"
+#include "base/metrics/histogram_macros.h"
+#include "base/strings/string_number_conversions.h"
 
 namespace bat_ads {
 
@@ -31,11 +33,36 @@ BatAdsClientMojoBridge::BatAdsClientMojoBridge(
 
 BatAdsClientMojoBridge::~BatAdsClientMojoBridge() = default;
 
+void BatAdsClientMojoBridge::SetPrefs(
+    base::flat_map<std::string, base::Value> prefs) {
+  pref_mirror_.Initialize(std::move(prefs));
+}
+
+void BatAdsClientMojoBridge::OnPrefChanged(
+    const std::string& path,
+    base::Value value) {
+  pref_mirror_.OnPrefChanged(path, std::move(value));
+}
+
+void BatAdsClientMojoBridge::SetAdEvents(
+    const base::flat_map<std::string, std::vector<uint64_t>>& ad_events) {
+  ad_event_history_.SetAll(
+      ads::AdEventHistory::History(ad_events.begin(), ad_events.end()));
+}
+
+void BatAdsClientMojoBridge::OnAdEventRecorded(
+    const std::string& ad_type,
+    const std::string& confirmation_type,
+    const uint64_t timestamp) {
+  ad_event_history_.Record(ad_type, confirmation_type, timestamp);
+}
+
 bool BatAdsClientMojoBridge::CanShowBackgroundNotifications() const {
   if (!connected())
     return false;
 
   bool can_show;
+  OnSyncCall();
   bat_ads_client_->CanShowBackgroundNotifications(&can_show);
   return can_show;
 }
@@ -46,6 +73,7 @@ bool BatAdsClientMojoBridge::IsNetworkConnectionAvailable() const {
   }
 
   bool is_available;
+  OnSyncCall();
   bat_ads_client_->IsNetworkConnectionAvailable(&is_available);
   return is_available;
 }
@@ -56,6 +84,7 @@ bool BatAdsClientMojoBridge::IsForeground() const {
   }
 
   bool is_foreground;
+  OnSyncCall();
   bat_ads_client_->IsForeground(&is_foreground);
   return is_foreground;
 }
@@ -66,6 +95,7 @@ bool BatAdsClientMojoBridge::IsFullScreen() const {
   }
 
   bool is_full_screen;
+  OnSyncCall();
   bat_ads_client_->IsFullScreen(&is_full_screen);
   return is_full_screen;
 }
@@ -76,6 +106,10 @@ void BatAdsClientMojoBridge::ShowNotification(
     return;
   }
 
+  UMA_HISTOGRAM_COUNTS_100("Brave.Ads.SyncCallsPerAdNotificationServed",
+                           sync_call_count_);
+  sync_call_count_ = 0;
+
   bat_ads_client_->ShowNotification(info.ToJson());
 }
 
@@ -85,6 +119,7 @@ bool BatAdsClientMojoBridge::ShouldShowNotifications() {
   }
 
   bool should_show;
+  OnSyncCall();
   bat_ads_client_->ShouldShowNotifications(&should_show);
   return should_show;
 }
@@ -101,6 +136,8 @@ void BatAdsClientMojoBridge::CloseNotification(
 void BatAdsClientMojoBridge::RecordAdEvent(const std::string& ad_type,
                                            const std::string& confirmation_type,
                                            const uint64_t timestamp) const {
+  ad_event_history_.Record(ad_type, confirmation_type, timestamp);
+
   if (!connected()) {
     return;
   }
@@ -111,13 +148,7 @@ void BatAdsClientMojoBridge::RecordAdEvent(const std::string& ad_type,
 std::vector<uint64_t> BatAdsClientMojoBridge::GetAdEvents(
     const std::string& ad_type,
     const std::string& confirmation_type) const {
-  if (!connected()) {
-    return {};
-  }
-
-  std::vector<uint64_t> ad_events;
-  bat_ads_client_->GetAdEvents(ad_type, confirmation_type, &ad_events);
-  return ad_events;
+  return ad_event_history_.Get(ad_type, confirmation_type);
 }
 
 void OnUrlRequest(
@@ -246,6 +277,7 @@ std::string BatAdsClientMojoBridge::LoadResourceForId(
     return value;
   }
 
+  OnSyncCall();
   bat_ads_client_->LoadResourceForId(id, &value);
   return value;
 }
@@ -287,10 +319,18 @@ bool BatAdsClientMojoBridge::GetBooleanPref(
     const std::string& path) const {
   bool value = false;
 
+  const base::Value* mirrored_value =
+      GetMirroredPref(path, base::Value::Type::BOOLEAN);
+  if (mirrored_value) {
+    value = mirrored_value->GetBool();
+    return value;
+  }
+
   if (!connected()) {
     return value;
   }
 
+  OnSyncCall();
   bat_ads_client_->GetBooleanPref(path, &value);
   return value;
 }
@@ -298,6 +338,8 @@ bool BatAdsClientMojoBridge::GetBooleanPref(
 void BatAdsClientMojoBridge::SetBooleanPref(
     const std::string& path,
     const bool value) {
+  pref_mirror_.Set(path, base::Value(value));
+
   if (!connected()) {
     return;
   }
@@ -309,10 +351,18 @@ int BatAdsClientMojoBridge::GetIntegerPref(
     const std::string& path) const {
   int value = 0;
 
+  const base::Value* mirrored_value =
+      GetMirroredPref(path, base::Value::Type::INTEGER);
+  if (mirrored_value) {
+    value = mirrored_value->GetInt();
+    return value;
+  }
+
   if (!connected()) {
     return value;
   }
 
+  OnSyncCall();
   bat_ads_client_->GetIntegerPref(path, &value);
   return value;
 }
@@ -320,6 +370,8 @@ int BatAdsClientMojoBridge::GetIntegerPref(
 void BatAdsClientMojoBridge::SetIntegerPref(
     const std::string& path,
     const int value) {
+  pref_mirror_.Set(path, base::Value(value));
+
   if (!connected()) {
     return;
   }
@@ -331,10 +383,18 @@ double BatAdsClientMojoBridge::GetDoublePref(
     const std::string& path) const {
   double value = 0.0;
 
+  const base::Value* mirrored_value =
+      GetMirroredPref(path, base::Value::Type::DOUBLE);
+  if (mirrored_value) {
+    value = mirrored_value->GetDouble();
+    return value;
+  }
+
   if (!connected()) {
     return value;
   }
 
+  OnSyncCall();
   bat_ads_client_->GetDoublePref(path, &value);
   return value;
 }
@@ -342,6 +402,8 @@ double BatAdsClientMojoBridge::GetDoublePref(
 void BatAdsClientMojoBridge::SetDoublePref(
     const std::string& path,
     const double value) {
+  pref_mirror_.Set(path, base::Value(value));
+
   if (!connected()) {
     return;
   }
@@ -353,10 +415,18 @@ std::string BatAdsClientMojoBridge::GetStringPref(
     const std::string& path) const {
   std::string value;
 
+  const base::Value* mirrored_value =
+      GetMirroredPref(path, base::Value::Type::STRING);
+  if (mirrored_value) {
+    value = mirrored_value->GetString();
+    return value;
+  }
+
   if (!connected()) {
     return value;
   }
 
+  OnSyncCall();
   bat_ads_client_->GetStringPref(path, &value);
   return value;
 }
@@ -364,6 +434,8 @@ std::string BatAdsClientMojoBridge::GetStringPref(
 void BatAdsClientMojoBridge::SetStringPref(
     const std::string& path,
     const std::string& value) {
+  pref_mirror_.Set(path, base::Value(value));
+
   if (!connected()) {
     return;
   }
@@ -375,10 +447,18 @@ int64_t BatAdsClientMojoBridge::GetInt64Pref(
     const std::string& path) const {
   int64_t value = 0;
 
+  const base::Value* mirrored_value =
+      GetMirroredPref(path, base::Value::Type::STRING);
+  if (mirrored_value) {
+    base::StringToInt64(mirrored_value->GetString(), &value);
+    return value;
+  }
+
   if (!connected()) {
     return value;
   }
 
+  OnSyncCall();
   bat_ads_client_->GetInt64Pref(path, &value);
   return value;
 }
@@ -386,6 +466,8 @@ int64_t BatAdsClientMojoBridge::GetInt64Pref(
 void BatAdsClientMojoBridge::SetInt64Pref(
     const std::string& path,
     const int64_t value) {
+  pref_mirror_.Set(path, base::Value(base::NumberToString(value)));
+
   if (!connected()) {
     return;
   }
@@ -397,10 +479,18 @@ uint64_t BatAdsClientMojoBridge::GetUint64Pref(
     const std::string& path) const {
   uint64_t value = 0;
 
+  const base::Value* mirrored_value =
+      GetMirroredPref(path, base::Value::Type::STRING);
+  if (mirrored_value) {
+    base::StringToUint64(mirrored_value->GetString(), &value);
+    return value;
+  }
+
   if (!connected()) {
     return value;
   }
 
+  OnSyncCall();
   bat_ads_client_->GetUint64Pref(path, &value);
   return value;
 }
@@ -408,6 +498,8 @@ uint64_t BatAdsClientMojoBridge::GetUint64Pref(
 void BatAdsClientMojoBridge::SetUint64Pref(
     const std::string& path,
     const uint64_t value) {
+  pref_mirror_.Set(path, base::Value(base::NumberToString(value)));
+
   if (!connected()) {
     return;
   }
@@ -417,6 +509,8 @@ void BatAdsClientMojoBridge::SetUint64Pref(
 
 void BatAdsClientMojoBridge::ClearPref(
     const std::string& path) {
+  pref_mirror_.Clear(path);
+
   if (!connected()) {
     return;
   }
@@ -430,4 +524,20 @@ bool BatAdsClientMojoBridge::connected() const {
   return bat_ads_client_.is_bound();
 }
 
+void BatAdsClientMojoBridge::OnSyncCall() const {
+  sync_call_count_++;
+}
+
+const base::Value* BatAdsClientMojoBridge::GetMirroredPref(
+    const std::string& path,
+    const base::Value::Type type) const {
+  // Prefs which are not mirrored fall back to a synchronous IPC
+  const base::Value* value = pref_mirror_.Get(path);
+  if (!value || value->type() != type) {
+    return nullptr;
+  }
+
+  return value;
+}
+
 }  // namespace bat_ads
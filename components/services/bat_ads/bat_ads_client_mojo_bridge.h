@@ -10,7 +10,11 @@
 #include <string>
 #include <vector>
 
+#include "base/containers/flat_map.h"
+#include "base/values.h"
+#include "bat/ads/ad_event_history.h"
 #include "bat/ads/ads_client.h"
+#include "brave/components/services/bat_ads/pref_mirror.h"
 #include "brave/components/services/bat_ads/public/interfaces/bat_ads.mojom.h"
 #include "mojo/public/cpp/bindings/associated_remote.h"
 #include "mojo/public/cpp/bindings/pending_associated_remote.h"
@@ -28,6 +32,19 @@ class BatAdsClientMojoBridge
   BatAdsClientMojoBridge(const BatAdsClientMojoBridge&) = delete;
   BatAdsClientMojoBridge& operator=(const BatAdsClientMojoBridge&) = delete;
 
+  void SetPrefs(
+      base::flat_map<std::string, base::Value> prefs);
+  void OnPrefChanged(
+      const std::string& path,
+      base::Value value);
+
+  void SetAdEvents(
+      const base::flat_map<std::string, std::vector<uint64_t>>& ad_events);
+  void OnAdEventRecorded(
+      const std::string& ad_type,
+      const std::string& confirmation_type,
+      const uint64_t timestamp);
+
   // AdsClient implementation
   bool CanShowBackgroundNotifications() const override;
 
@@ -136,7 +153,26 @@ class BatAdsClientMojoBridge
  private:
   bool connected() const;
 
+  // Counts synchronous calls back to the browser, which block bat ads until
+  // the browser replies
+  void OnSyncCall() const;
+
+  const base::Value* GetMirroredPref(
+      const std::string& path,
+      const base::Value::Type type) const;
+
   mojo::AssociatedRemote<mojom::BatAdsClient> bat_ads_client_;
+
+  PrefMirror pref_mirror_;
+
+  // Mirrors the ad events recorded by the browser. Ad events recorded by bat
+  // ads are recorded here before they are sent to the browser, which only
+  // notifies ad events recorded by other profiles. |mutable| because recording
+  // is |const| in |ads::AdsClient|
+  mutable ads::AdEventHistory ad_event_history_;
+
+  // Synchronous calls since the last ad notification was served
+  mutable int sync_call_count_ = 0;
 };
 
 }  // namespace bat_ads
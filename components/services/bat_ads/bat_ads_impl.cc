@@ -23,6 +23,21 @@ namespace bat_ads {
 
 namespace {
 
+std::string ReadSharedMemoryRegion(
+    const base::ReadOnlySharedMemoryRegion& region) {
+  if (!region.IsValid()) {
+    return "";
+  }
+
+  const base::ReadOnlySharedMemoryMapping mapping = region.Map();
+  if (!mapping.IsValid()) {
+    return "";
+  }
+
+  return std::string(static_cast<const char*>(mapping.memory()),
+                     mapping.size());
+}
+
 ads::AdContentInfo::LikeAction ToAdsLikeAction(
     const int action) {
   return static_cast<ads::AdContentInfo::LikeAction>(action);
@@ -44,6 +59,30 @@ BatAdsImpl::BatAdsImpl(
 
 BatAdsImpl::~BatAdsImpl() = default;
 
+void BatAdsImpl::SetPrefs(
+    base::flat_map<std::string, base::Value> prefs) {
+  bat_ads_client_mojo_proxy_->SetPrefs(std::move(prefs));
+}
+
+void BatAdsImpl::OnPrefChanged(
+    const std::string& path,
+    base::Value value) {
+  bat_ads_client_mojo_proxy_->OnPrefChanged(path, std::move(value));
+}
+
+void BatAdsImpl::SetAdEvents(
+    const base::flat_map<std::string, std::vector<uint64_t>>& ad_events) {
+  bat_ads_client_mojo_proxy_->SetAdEvents(ad_events);
+}
+
+void BatAdsImpl::OnAdEventRecorded(
+    const std::string& ad_type,
+    const std::string& confirmation_type,
+    const uint64_t timestamp) {
+  bat_ads_client_mojo_proxy_->OnAdEventRecorded(ad_type, confirmation_type,
+      timestamp);
+}
+
 void BatAdsImpl::Initialize(
     InitializeCallback callback) {
   auto* holder = new CallbackHolder<InitializeCallback>(AsWeakPtr(),
@@ -72,14 +111,14 @@ void BatAdsImpl::OnAdsSubdivisionTargetingCodeHasChanged() {
 
 void BatAdsImpl::OnHtmlLoaded(const int32_t tab_id,
                               const std::vector<std::string>& redirect_chain,
-                              const std::string& html) {
-  ads_->OnHtmlLoaded(tab_id, redirect_chain, html);
+                              base::ReadOnlySharedMemoryRegion html) {
+  ads_->OnHtmlLoaded(tab_id, redirect_chain, ReadSharedMemoryRegion(html));
 }
 
 void BatAdsImpl::OnTextLoaded(const int32_t tab_id,
                               const std::vector<std::string>& redirect_chain,
-                              const std::string& text) {
-  ads_->OnTextLoaded(tab_id, redirect_chain, text);
+                              base::ReadOnlySharedMemoryRegion text) {
+  ads_->OnTextLoaded(tab_id, redirect_chain, ReadSharedMemoryRegion(text));
 }
 
 void BatAdsImpl::OnUserGesture(const int32_t page_transition_type) {
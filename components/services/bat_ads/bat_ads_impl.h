@@ -12,7 +12,10 @@
 #include <utility>
 #include <vector>
 
+#include "base/containers/flat_map.h"
+#include "base/memory/read_only_shared_memory_region.h"
 #include "base/memory/weak_ptr.h"
+#include "base/values.h"
 #include "brave/components/services/bat_ads/public/interfaces/bat_ads.mojom.h"
 #include "mojo/public/cpp/bindings/interface_request.h"
 #include "bat/ads/ads.h"
@@ -38,6 +41,19 @@ class BatAdsImpl :
   BatAdsImpl& operator=(const BatAdsImpl&) = delete;
 
   // Overridden from mojom::BatAds:
+  void SetPrefs(
+      base::flat_map<std::string, base::Value> prefs) override;
+  void OnPrefChanged(
+      const std::string& path,
+      base::Value value) override;
+  void SetAdEvents(
+      const base::flat_map<std::string, std::vector<uint64_t>>& ad_events)
+      override;
+  void OnAdEventRecorded(
+      const std::string& ad_type,
+      const std::string& confirmation_type,
+      const uint64_t timestamp) override;
+
   void Initialize(
       InitializeCallback callback) override;
   void Shutdown(
@@ -50,11 +66,11 @@ class BatAdsImpl :
 
   void OnHtmlLoaded(const int32_t tab_id,
                     const std::vector<std::string>& redirect_chain,
-                    const std::string& html) override;
+                    base::ReadOnlySharedMemoryRegion html) override;
 
   void OnTextLoaded(const int32_t tab_id,
                     const std::vector<std::string>& redirect_chain,
-                    const std::string& text) override;
+                    base::ReadOnlySharedMemoryRegion text) override;
 
   void OnUserGesture(const int32_t page_transition_type) override;
 
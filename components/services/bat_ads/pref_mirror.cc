@@ -0,0 +1,63 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/services/bat_ads/pref_mirror.h"
+
+#include <utility>
+
+namespace bat_ads {
+
+PrefMirror::PrefMirror() = default;
+
+PrefMirror::~PrefMirror() = default;
+
+void PrefMirror::Initialize(PrefMap prefs) {
+  prefs_ = std::move(prefs);
+  pending_writes_.clear();
+}
+
+void PrefMirror::OnPrefChanged(const std::string& path, base::Value value) {
+  const auto iter = pending_writes_.find(path);
+  if (iter != pending_writes_.end()) {
+    if (iter->second != value) {
+      return;
+    }
+
+    pending_writes_.erase(iter);
+  }
+
+  prefs_[path] = std::move(value);
+}
+
+const base::Value* PrefMirror::Get(const std::string& path) const {
+  const auto iter = prefs_.find(path);
+  if (iter == prefs_.end()) {
+    return nullptr;
+  }
+
+  return &iter->second;
+}
+
+void PrefMirror::Set(const std::string& path, base::Value value) {
+  const auto iter = prefs_.find(path);
+  if (iter == prefs_.end()) {
+    return;
+  }
+
+  // The browser does not notify a change if the value is unchanged
+  if (iter->second == value) {
+    return;
+  }
+
+  pending_writes_[path] = value.Clone();
+  iter->second = std::move(value);
+}
+
+void PrefMirror::Clear(const std::string& path) {
+  prefs_.erase(path);
+  pending_writes_.erase(path);
+}
+
+}  // namespace bat_ads
@@ -0,0 +1,57 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_SERVICES_BAT_ADS_PREF_MIRROR_H_
+#define BRAVE_COMPONENTS_SERVICES_BAT_ADS_PREF_MIRROR_H_
+
+#include <string>
+
+#include "base/containers/flat_map.h"
+#include "base/values.h"
+
+namespace bat_ads {
+
+// Mirrors the ads prefs owned by the browser process so that bat ads can read
+// prefs without a synchronous IPC. The browser pushes a snapshot of the prefs
+// when bat ads is created followed by a notification for each change
+class PrefMirror {
+ public:
+  using PrefMap = base::flat_map<std::string, base::Value>;
+
+  PrefMirror();
+  ~PrefMirror();
+
+  PrefMirror(const PrefMirror&) = delete;
+  PrefMirror& operator=(const PrefMirror&) = delete;
+
+  // Replaces the mirrored prefs with a snapshot from the browser
+  void Initialize(PrefMap prefs);
+
+  // Called when the browser notifies that a mirrored pref has changed
+  void OnPrefChanged(const std::string& path, base::Value value);
+
+  // Returns the mirrored value for |path| or nullptr if |path| is not mirrored
+  const base::Value* Get(const std::string& path) const;
+
+  // Updates the mirrored value for |path| ahead of the browser notifying that
+  // the pref has changed. Does nothing if |path| is not mirrored
+  void Set(const std::string& path, base::Value value);
+
+  // Removes |path| from the mirror until the browser notifies the default
+  // value
+  void Clear(const std::string& path);
+
+ private:
+  PrefMap prefs_;
+
+  // Values set by bat ads for which the browser has not yet notified a change.
+  // Notifications for other values were sent before the browser received the
+  // write and are ignored so that a stale value is not mirrored
+  PrefMap pending_writes_;
+};
+
+}  // namespace bat_ads
+
+#endif  // BRAVE_COMPONENTS_SERVICES_BAT_ADS_PREF_MIRROR_H_
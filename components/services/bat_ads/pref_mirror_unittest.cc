@@ -0,0 +1,143 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/services/bat_ads/pref_mirror.h"
+
+#include <string>
+#include <utility>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=BatAdsPrefMirror*
+
+namespace bat_ads {
+
+namespace {
+
+const char kPath[] = "brave.brave_ads.ads_per_hour";
+
+}  // namespace
+
+class BatAdsPrefMirrorTest : public ::testing::Test {
+ protected:
+  BatAdsPrefMirrorTest() {
+    PrefMirror::PrefMap prefs;
+    prefs[kPath] = base::Value("1");
+    pref_mirror_.Initialize(std::move(prefs));
+  }
+
+  ~BatAdsPrefMirrorTest() override = default;
+
+  std::string GetMirroredValue() const {
+    const base::Value* value = pref_mirror_.Get(kPath);
+    if (!value) {
+      return "";
+    }
+
+    return value->GetString();
+  }
+
+  PrefMirror pref_mirror_;
+};
+
+TEST_F(BatAdsPrefMirrorTest, GetPrefFromSnapshot) {
+  // Arrange
+
+  // Act
+  const std::string value = GetMirroredValue();
+
+  // Assert
+  EXPECT_EQ("1", value);
+}
+
+TEST_F(BatAdsPrefMirrorTest, DoNotMirrorUnknownPref) {
+  // Arrange
+  pref_mirror_.Set("brave.brave_ads.unknown", base::Value(true));
+
+  // Act
+  const base::Value* value = pref_mirror_.Get("brave.brave_ads.unknown");
+
+  // Assert
+  EXPECT_EQ(nullptr, value);
+}
+
+TEST_F(BatAdsPrefMirrorTest, ApplyPrefChangedByBrowser) {
+  // Arrange
+
+  // Act
+  pref_mirror_.OnPrefChanged(kPath, base::Value("3"));
+
+  // Assert
+  EXPECT_EQ("3", GetMirroredValue());
+}
+
+TEST_F(BatAdsPrefMirrorTest, ReadPrefAfterSetBeforeBrowserNotifies) {
+  // Arrange
+
+  // Act
+  pref_mirror_.Set(kPath, base::Value("2"));
+
+  // Assert
+  EXPECT_EQ("2", GetMirroredValue());
+}
+
+TEST_F(BatAdsPrefMirrorTest, IgnoreStaleNotificationsForPendingWrites) {
+  // Arrange
+  pref_mirror_.Set(kPath, base::Value("2"));
+  pref_mirror_.Set(kPath, base::Value("3"));
+
+  // Act
+  pref_mirror_.OnPrefChanged(kPath, base::Value("2"));
+
+  // Assert
+  EXPECT_EQ("3", GetMirroredValue());
+}
+
+TEST_F(BatAdsPrefMirrorTest, ApplyBrowserChangeAfterPendingWriteIsNotified) {
+  // Arrange
+  pref_mirror_.Set(kPath, base::Value("2"));
+  pref_mirror_.OnPrefChanged(kPath, base::Value("2"));
+
+  // Act
+  pref_mirror_.OnPrefChanged(kPath, base::Value("5"));
+
+  // Assert
+  EXPECT_EQ("5", GetMirroredValue());
+}
+
+TEST_F(BatAdsPrefMirrorTest, SetUnchangedValueDoesNotWaitForNotification) {
+  // Arrange
+  pref_mirror_.Set(kPath, base::Value("1"));
+
+  // Act
+  pref_mirror_.OnPrefChanged(kPath, base::Value("5"));
+
+  // Assert
+  EXPECT_EQ("5", GetMirroredValue());
+}
+
+TEST_F(BatAdsPrefMirrorTest, ClearPref) {
+  // Arrange
+  pref_mirror_.Set(kPath, base::Value("2"));
+
+  // Act
+  pref_mirror_.Clear(kPath);
+
+  // Assert
+  EXPECT_EQ(nullptr, pref_mirror_.Get(kPath));
+}
+
+TEST_F(BatAdsPrefMirrorTest, MirrorDefaultValueAfterClearPref) {
+  // Arrange
+  pref_mirror_.Clear(kPath);
+
+  // Act
+  pref_mirror_.OnPrefChanged(kPath, base::Value("0"));
+
+  // Assert
+  EXPECT_EQ("0", GetMirroredValue());
+}
+
+}  // namespace bat_ads
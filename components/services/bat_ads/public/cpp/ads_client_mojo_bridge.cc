@@ -87,20 +87,6 @@ void AdsClientMojoBridge::ShouldShowNotifications(
   std::move(callback).Run(ads_client_->ShouldShowNotifications());
 }
 
-bool AdsClientMojoBridge::GetAdEvents(const std::string& ad_type,
-                                      const std::string& confirmation_type,
-                                      std::vector<uint64_t>* out_ad_events) {
-  DCHECK(out_ad_events);
-  *out_ad_events = ads_client_->GetAdEvents(ad_type, confirmation_type);
-  return true;
-}
-
-void AdsClientMojoBridge::GetAdEvents(const std::string& ad_type,
-                                      const std::string& confirmation_type,
-                                      GetAdEventsCallback callback) {
-  std::move(callback).Run(ads_client_->GetAdEvents(ad_type, confirmation_type));
-}
-
 bool AdsClientMojoBridge::LoadResourceForId(
     const std::string& id,
     std::string* out_value) {
@@ -44,12 +44,6 @@ class AdsClientMojoBridge
   bool ShouldShowNotifications(bool* out_should_show) override;
   void ShouldShowNotifications(
       ShouldShowNotificationsCallback callback) override;
-  bool GetAdEvents(const std::string& ad_type,
-                   const std::string& confirmation_type,
-                   std::vector<uint64_t>* out_ad_events) override;
-  void GetAdEvents(const std::string& ad_type,
-                   const std::string& confirmation_type,
-                   GetAdEventsCallback callback) override;
 
   bool LoadResourceForId(
       const std::string& id,
@@ -5,12 +5,14 @@
 
 #include "brave/components/speedreader/speedreader_url_loader.h"
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <utility>
 
 #include "base/bind.h"
 #include "base/metrics/histogram_macros.h"
+#include "base/sequence_checker.h"
 #include "base/task/post_task.h"
 #include "base/task/thread_pool.h"
 #include "brave/components/speedreader/rust/ffi/speedreader.h"
@@ -25,8 +27,118 @@ namespace {
 
 constexpr uint32_t kReadBufferSize = 32768;
 
+// The original body is kept up to this size to be able to send it untouched
+// if distilling fails. Larger pages are not distilled.
+constexpr size_t kMaxOriginalBodySize = 8 * 1024 * 1024;
+
+// TODO(brave-browser/issues/10372): would be better to pass explicit signal
+// back from rewriter to indicate if content was found
+constexpr size_t kMinDistilledSize = 1024;
+
 }  // namespace
 
+// Owns a streaming rewriter which is only used on the distilling sequence.
+// Output is posted back to the loader as soon as the rewriter produces it,
+// followed by a single notification once distilling has finished.
+class StreamingDistiller {
+ public:
+  using OutputCallback = base::RepeatingCallback<void(std::string)>;
+  using FinishedCallback = base::OnceCallback<void(bool)>;
+
+  StreamingDistiller(scoped_refptr<base::SequencedTaskRunner> reply_task_runner,
+                     OutputCallback output_callback,
+                     FinishedCallback finished_callback)
+      : reply_task_runner_(std::move(reply_task_runner)),
+        output_callback_(std::move(output_callback)),
+        finished_callback_(std::move(finished_callback)) {
+    DETACH_FROM_SEQUENCE(sequence_checker_);
+  }
+
+  ~StreamingDistiller() { DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_); }
+
+  StreamingDistiller(const StreamingDistiller&) = delete;
+  StreamingDistiller& operator=(const StreamingDistiller&) = delete;
+
+  // Must be called before any chunk is written.
+  void set_rewriter(std::unique_ptr<Rewriter> rewriter) {
+    rewriter_ = std::move(rewriter);
+  }
+
+  // Output sink of the rewriter.
+  static void OnOutput(const char* chunk, size_t chunk_len, void* user_data) {
+    static_cast<StreamingDistiller*>(user_data)->pending_output_.append(
+        chunk, chunk_len);
+  }
+
+  void Write(std::string chunk) {
+    DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+    if (!rewriter_)
+      return;
+
+    const base::TimeTicks start_time = base::TimeTicks::Now();
+    const int result = rewriter_->Write(chunk.data(), chunk.length());
+    distill_time_ += base::TimeTicks::Now() - start_time;
+    if (result != 0) {
+      Finish(false);
+      return;
+    }
+
+    FlushOutput();
+  }
+
+  void End() {
+    DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+    if (!rewriter_) {
+      Finish(false);
+      return;
+    }
+
+    const base::TimeTicks start_time = base::TimeTicks::Now();
+    const int result = rewriter_->End();
+    distill_time_ += base::TimeTicks::Now() - start_time;
+    if (result != 0) {
+      Finish(false);
+      return;
+    }
+
+    UMA_HISTOGRAM_TIMES("Brave.Speedreader.Distill", distill_time_);
+    FlushOutput();
+    Finish(true);
+  }
+
+ private:
+  void FlushOutput() {
+    if (pending_output_.empty())
+      return;
+
+    reply_task_runner_->PostTask(
+        FROM_HERE,
+        base::BindOnce(output_callback_, std::move(pending_output_)));
+    pending_output_.clear();
+  }
+
+  void Finish(bool success) {
+    // Writing may have failed before, which has already been reported.
+    if (!finished_callback_)
+      return;
+
+    rewriter_.reset();
+    pending_output_.clear();
+    reply_task_runner_->PostTask(
+        FROM_HERE, base::BindOnce(std::move(finished_callback_), success));
+  }
+
+  scoped_refptr<base::SequencedTaskRunner> reply_task_runner_;
+  OutputCallback output_callback_;
+  FinishedCallback finished_callback_;
+
+  std::unique_ptr<Rewriter> rewriter_;
+  std::string pending_output_;
+  base::TimeDelta distill_time_;
+
+  SEQUENCE_CHECKER(sequence_checker_);
+};
+
 // static
 std::tuple<mojo::PendingRemote<network::mojom::URLLoader>,
            mojo::PendingReceiver<network::mojom::URLLoaderClient>,
@@ -69,6 +181,7 @@ SpeedReaderURLLoader::SpeedReaderURLLoader(
       body_producer_watcher_(FROM_HERE,
                              mojo::SimpleWatcher::ArmingPolicy::MANUAL,
                              std::move(task_runner)),
+      distiller_(nullptr, base::OnTaskRunnerDeleter(nullptr)),
       rewriter_service_(rewriter_service) {}
 
 SpeedReaderURLLoader::~SpeedReaderURLLoader() = default;
@@ -122,6 +235,27 @@ void SpeedReaderURLLoader::OnStartLoadingResponseBody(
     mojo::ScopedDataPipeConsumerHandle body) {
   VLOG(2) << __func__ << " " << response_url_;
   state_ = State::kLoading;
+  body_start_time_ = base::TimeTicks::Now();
+  if (!throttle_ || !rewriter_service_) {
+    Abort();
+    return;
+  }
+
+  // The rewriter is kept alive on its own sequence for the whole load so
+  // that chunks are distilled as soon as they arrive.
+  distill_task_runner_ = base::ThreadPool::CreateSequencedTaskRunner(
+      {base::TaskPriority::USER_BLOCKING});
+  distiller_ = std::unique_ptr<StreamingDistiller, base::OnTaskRunnerDeleter>(
+      new StreamingDistiller(
+          task_runner_,
+          base::BindRepeating(&SpeedReaderURLLoader::OnDistilledOutput,
+                              weak_factory_.GetWeakPtr()),
+          base::BindOnce(&SpeedReaderURLLoader::OnDistillingFinished,
+                         weak_factory_.GetWeakPtr())),
+      base::OnTaskRunnerDeleter(distill_task_runner_));
+  distiller_->set_rewriter(rewriter_service_->MakeRewriter(
+      response_url_, &StreamingDistiller::OnOutput, distiller_.get()));
+
   body_consumer_handle_ = std::move(body);
   body_consumer_watcher_.Watch(
       body_consumer_handle_.get(),
@@ -192,20 +326,25 @@ void SpeedReaderURLLoader::ResumeReadingBodyFromNet() {
 }
 
 void SpeedReaderURLLoader::OnBodyReadable(MojoResult) {
-  DCHECK_EQ(State::kLoading, state_);
+  DCHECK(state_ == State::kLoading || state_ == State::kSending);
 
-  size_t start_size = buffered_body_.size();
+  std::string chunk(kReadBufferSize, '\0');
   uint32_t read_bytes = kReadBufferSize;
-  buffered_body_.resize(start_size + read_bytes);
   MojoResult result = body_consumer_handle_->ReadData(
-      &buffered_body_[0] + start_size, &read_bytes, MOJO_READ_DATA_FLAG_NONE);
+      &chunk[0], &read_bytes, MOJO_READ_DATA_FLAG_NONE);
   switch (result) {
     case MOJO_RESULT_OK:
       break;
     case MOJO_RESULT_FAILED_PRECONDITION:
       // Reading is finished.
-      buffered_body_.resize(start_size);
-      MaybeLaunchSpeedreader();
+      body_read_completed_ = true;
+      if (distiller_) {
+        distill_task_runner_->PostTask(
+            FROM_HERE, base::BindOnce(&StreamingDistiller::End,
+                                      base::Unretained(distiller_.get())));
+        return;
+      }
+      MaybeCompleteSending();
       return;
     case MOJO_RESULT_SHOULD_WAIT:
       body_consumer_watcher_.ArmOrNotify();
@@ -216,71 +355,89 @@ void SpeedReaderURLLoader::OnBodyReadable(MojoResult) {
   }
 
   DCHECK_EQ(MOJO_RESULT_OK, result);
-  buffered_body_.resize(start_size + read_bytes);
-  // TODO(iefremov): We actually can partially |pumpContent| to speedreader,
-  // but skipping it for now to simplify things. Pumping is not free in terms
-  // of CPU ticks, so we will have to keep alive speedreader instance on another
-  // thread.
+  chunk.resize(read_bytes);
+  OnBodyChunk(std::move(chunk));
+  if (state_ == State::kAborted || body_read_completed_)
+    return;
 
   body_consumer_watcher_.ArmOrNotify();
 }
 
 void SpeedReaderURLLoader::OnBodyWritable(MojoResult r) {
   DCHECK_EQ(State::kSending, state_);
-  if (bytes_remaining_in_buffer_ > 0) {
-    SendReceivedBodyToClient();
-  } else {
-    CompleteSending();
-  }
+  waiting_for_writable_ = false;
+  SendPendingOutputToClient();
 }
 
-void SpeedReaderURLLoader::MaybeLaunchSpeedreader() {
+void SpeedReaderURLLoader::OnBodyChunk(std::string chunk) {
+  if (!distiller_) {
+    // Distilling has been given up, so the body is passed through.
+    AppendOutput(chunk);
+    return;
+  }
+
   DCHECK_EQ(State::kLoading, state_);
-  if (!throttle_ || !rewriter_service_) {
-    Abort();
+  original_body_.append(chunk);
+  UpdatePeakBufferedBytes();
+  if (original_body_.size() > kMaxOriginalBodySize) {
+    VLOG(2) << __func__ << " body is too large to distill";
+    FallbackToOriginalBody();
     return;
   }
 
-  VLOG(2) << __func__ << " buffered body size = " << buffered_body_.size();
-  bytes_remaining_in_buffer_ = buffered_body_.size();
-
-  if (bytes_remaining_in_buffer_ > 0) {
-    // Offload heavy distilling to another thread.
-    base::ThreadPool::PostTaskAndReplyWithResult(
-        FROM_HERE, {base::TaskPriority::USER_BLOCKING},
-        base::BindOnce(
-            [](std::string data, std::unique_ptr<Rewriter> rewriter,
-               const std::string& stylesheet) -> auto {
-              SCOPED_UMA_HISTOGRAM_TIMER("Brave.Speedreader.Distill");
-              int written = rewriter->Write(data.c_str(), data.length());
-              // Error occurred
-              if (written != 0) {
-                return data;
-              }
-
-              rewriter->End();
-              const std::string& transformed = rewriter->GetOutput();
-
-              // TODO(brave-browser/issues/10372): would be better to pass
-              // explicit signal back from rewriter to indicate if content was
-              // found
-              if (transformed.length() < 1024) {
-                return data;
-              }
-
-              return stylesheet + transformed;
-            },
-            std::move(buffered_body_),
-            rewriter_service_->MakeRewriter(response_url_),
-            rewriter_service_->GetContentStylesheet()),
-        base::BindOnce(&SpeedReaderURLLoader::CompleteLoading,
-                       weak_factory_.GetWeakPtr()));
+  distill_task_runner_->PostTask(
+      FROM_HERE,
+      base::BindOnce(&StreamingDistiller::Write,
+                     base::Unretained(distiller_.get()), std::move(chunk)));
+}
+
+void SpeedReaderURLLoader::OnDistilledOutput(std::string output) {
+  // Output may still arrive after distilling has been given up.
+  if (!distiller_ || state_ == State::kAborted)
+    return;
+
+  DCHECK_EQ(State::kLoading, state_);
+  distilled_size_ += output.size();
+  pending_output_.append(output);
+  UpdatePeakBufferedBytes();
+}
+
+void SpeedReaderURLLoader::OnDistillingFinished(bool success) {
+  if (!distiller_ || state_ == State::kAborted)
+    return;
+
+  DCHECK_EQ(State::kLoading, state_);
+  distiller_.reset();
+  if (!success || distilled_size_ < kMinDistilledSize) {
+    // Either distilling failed or the page has no readable content. Nothing
+    // has been sent yet, so the page is loaded untouched.
+    VLOG(2) << __func__ << " falling back to the original body "
+            << response_url_;
+    FallbackToOriginalBody();
     return;
   }
-  CompleteLoading(std::move(buffered_body_));
+
+  // The whole body has been distilled, so the original body is no longer
+  // needed for fallback.
+  DCHECK(body_read_completed_);
+  std::string().swap(original_body_);
+  std::string body = rewriter_service_->GetContentStylesheet();
+  body.append(pending_output_);
+  std::string().swap(pending_output_);
+  StartSending(std::move(body));
 }
 
-void SpeedReaderURLLoader::CompleteLoading(std::string body) {
+void SpeedReaderURLLoader::FallbackToOriginalBody() {
+  DCHECK_EQ(State::kLoading, state_);
+  distiller_.reset();
+  pending_output_.clear();
+
+  std::string body;
+  body.swap(original_body_);
+  StartSending(std::move(body));
+}
+
+void SpeedReaderURLLoader::StartSending(std::string body) {
   DCHECK_EQ(State::kLoading, state_);
   state_ = State::kSending;
 
@@ -289,9 +446,6 @@ void SpeedReaderURLLoader::CompleteLoading(std::string body) {
     return;
   }
 
-  buffered_body_ = std::move(body);
-  bytes_remaining_in_buffer_ = buffered_body_.size();
-
   throttle_->Resume();
   mojo::ScopedDataPipeConsumerHandle body_to_send;
   MojoResult result =
@@ -311,9 +465,20 @@ void SpeedReaderURLLoader::CompleteLoading(std::string body) {
   destination_url_loader_client_->OnStartLoadingResponseBody(
       std::move(body_to_send));
 
-  DCHECK(bytes_remaining_in_buffer_);
-  if (bytes_remaining_in_buffer_) {
-    SendReceivedBodyToClient();
+  AppendOutput(body);
+}
+
+void SpeedReaderURLLoader::AppendOutput(base::StringPiece output) {
+  DCHECK_EQ(State::kSending, state_);
+  pending_output_.append(output.data(), output.size());
+  UpdatePeakBufferedBytes();
+  if (!waiting_for_writable_)
+    SendPendingOutputToClient();
+}
+
+void SpeedReaderURLLoader::MaybeCompleteSending() {
+  if (state_ != State::kSending || !body_read_completed_ || distiller_ ||
+      !pending_output_.empty()) {
     return;
   }
 
@@ -323,6 +488,8 @@ void SpeedReaderURLLoader::CompleteLoading(std::string body) {
 void SpeedReaderURLLoader::CompleteSending() {
   DCHECK_EQ(State::kSending, state_);
   state_ = State::kCompleted;
+  UMA_HISTOGRAM_MEMORY_KB("Brave.Speedreader.PeakBufferedMemory",
+                          peak_buffered_bytes_ / 1024);
   // Call client's OnComplete() if |this|'s OnComplete() has already been
   // called.
   if (complete_status_.has_value())
@@ -334,15 +501,16 @@ void SpeedReaderURLLoader::CompleteSending() {
   body_producer_handle_.reset();
 }
 
-void SpeedReaderURLLoader::SendReceivedBodyToClient() {
+void SpeedReaderURLLoader::SendPendingOutputToClient() {
   DCHECK_EQ(State::kSending, state_);
-  // Send the buffered data first.
-  DCHECK_GT(bytes_remaining_in_buffer_, 0u);
-  size_t start_position = buffered_body_.size() - bytes_remaining_in_buffer_;
-  uint32_t bytes_sent = bytes_remaining_in_buffer_;
-  MojoResult result =
-      body_producer_handle_->WriteData(buffered_body_.data() + start_position,
-                                       &bytes_sent, MOJO_WRITE_DATA_FLAG_NONE);
+  if (pending_output_.empty()) {
+    MaybeCompleteSending();
+    return;
+  }
+
+  uint32_t bytes_sent = pending_output_.size();
+  MojoResult result = body_producer_handle_->WriteData(
+      pending_output_.data(), &bytes_sent, MOJO_WRITE_DATA_FLAG_NONE);
   switch (result) {
     case MOJO_RESULT_OK:
       break;
@@ -352,19 +520,35 @@ void SpeedReaderURLLoader::SendReceivedBodyToClient() {
       Abort();
       return;
     case MOJO_RESULT_SHOULD_WAIT:
+      waiting_for_writable_ = true;
       body_producer_watcher_.ArmOrNotify();
       return;
     default:
       NOTREACHED();
       return;
   }
-  bytes_remaining_in_buffer_ -= bytes_sent;
+
+  if (!first_byte_sent_) {
+    first_byte_sent_ = true;
+    UMA_HISTOGRAM_TIMES("Brave.Speedreader.TimeToFirstByte",
+                        base::TimeTicks::Now() - body_start_time_);
+  }
+
+  pending_output_.erase(0, bytes_sent);
+  waiting_for_writable_ = true;
   body_producer_watcher_.ArmOrNotify();
 }
 
+void SpeedReaderURLLoader::UpdatePeakBufferedBytes() {
+  peak_buffered_bytes_ =
+      std::max(peak_buffered_bytes_,
+               original_body_.size() + pending_output_.size());
+}
+
 void SpeedReaderURLLoader::Abort() {
   VLOG(2) << __func__ << " " << response_url_;
   state_ = State::kAborted;
+  distiller_.reset();
   body_consumer_watcher_.Cancel();
   body_producer_watcher_.Cancel();
   source_url_loader_.reset();
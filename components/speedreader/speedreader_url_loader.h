@@ -6,6 +6,7 @@
 #ifndef BRAVE_COMPONENTS_SPEEDREADER_SPEEDREADER_URL_LOADER_H_
 #define BRAVE_COMPONENTS_SPEEDREADER_SPEEDREADER_URL_LOADER_H_
 
+#include <memory>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -13,7 +14,9 @@
 #include "base/callback.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/weak_ptr.h"
+#include "base/sequenced_task_runner.h"
 #include "base/strings/string_piece.h"
+#include "base/time/time.h"
 #include "mojo/public/cpp/bindings/pending_receiver.h"
 #include "mojo/public/cpp/bindings/pending_remote.h"
 #include "mojo/public/cpp/bindings/receiver.h"
@@ -27,8 +30,10 @@ namespace speedreader {
 
 class SpeedReaderThrottle;
 class SpeedreaderRewriterService;
+class StreamingDistiller;
 
-// Loads the whole response body and tries to Speedreader-distill it.
+// Streams the response body through a Speedreader rewriter as it arrives and
+// sends the distilled version to the destination once distilling succeeded.
 // Cargoculted from |`SniffingURLLoader|.
 //
 // This loader has five states:
@@ -37,14 +42,19 @@ class SpeedreaderRewriterService;
 //               finished (= OnComplete() is called). When body is provided, the
 //               state is changed to kLoading. Otherwise the state goes to
 //               kCompleted.
-// kLoading: Receives the body from the source loader and distills the page.
-//            The received body is kept in this loader until distilling
-//            is finished. When all body has been received and distilling is
-//            done, this loader will dispatch queued messages like
-//            OnStartLoadingResponseBody() to the destination
-//            loader client, and then the state is changed to kSending.
-// kSending: Receives the body and sends it to the destination loader client.
-//           The state changes to kCompleted after all data is sent.
+// kLoading: Receives the body from the source loader and feeds it to the
+//           rewriter chunk by chunk. A copy of the original body is kept (up to
+//           |kMaxOriginalBodySize|) so that it can be sent untouched if
+//           distilling fails. Distilled output is buffered until the rewriter
+//           has finished, as a failure after part of it was sent would leave
+//           the page truncated. Once distilling succeeded or failed, this
+//           loader will dispatch queued messages like
+//           OnStartLoadingResponseBody() to the destination loader client, and
+//           then the state is changed to kSending.
+// kSending: Sends either the distilled output or the original body to the
+//           destination loader client. If distilling failed before the whole
+//           body was received, the rest of the body is passed through as it
+//           arrives. The state changes to kCompleted after all data is sent.
 // kCompleted: All data has been sent to the destination loader.
 // kAborted: Unexpected behavior happens. Watchers, pipes and the binding from
 //           the source loader to |this| are stopped. All incoming messages from
@@ -112,12 +122,23 @@ class SpeedReaderURLLoader : public network::mojom::URLLoaderClient,
 
   void OnBodyReadable(MojoResult);
   void OnBodyWritable(MojoResult);
-  void MaybeLaunchSpeedreader();
+  void OnBodyChunk(std::string chunk);
 
-  // Gets either distilled or untouched body.
-  void CompleteLoading(std::string body);
+  // Called on |task_runner_| with output of the rewriter.
+  void OnDistilledOutput(std::string output);
+  void OnDistillingFinished(bool success);
+
+  // Stops distilling and sends the original body instead.
+  void FallbackToOriginalBody();
+
+  // Starts sending |body| to the destination, which is either the beginning
+  // of the distilled output or the original body.
+  void StartSending(std::string body);
+  void AppendOutput(base::StringPiece output);
+  void MaybeCompleteSending();
   void CompleteSending();
-  void SendReceivedBodyToClient();
+  void SendPendingOutputToClient();
+  void UpdatePeakBufferedBytes();
 
   void Abort();
 
@@ -138,9 +159,22 @@ class SpeedReaderURLLoader : public network::mojom::URLLoaderClient,
   // Set if OnComplete() is called during distilling.
   base::Optional<network::URLLoaderCompletionStatus> complete_status_;
 
-  // Note that this could be replaced by a distilled version.
-  std::string buffered_body_;
-  size_t bytes_remaining_in_buffer_;
+  // Lives on |distill_task_runner_|, null unless distilling is in progress.
+  scoped_refptr<base::SequencedTaskRunner> distill_task_runner_;
+  std::unique_ptr<StreamingDistiller, base::OnTaskRunnerDeleter> distiller_;
+
+  // Copy of the original body, kept until the output is chosen.
+  std::string original_body_;
+  // Distilled output while loading, then output which has not been written to
+  // the destination yet.
+  std::string pending_output_;
+  size_t distilled_size_ = 0;
+  bool body_read_completed_ = false;
+  bool waiting_for_writable_ = false;
+
+  base::TimeTicks body_start_time_;
+  bool first_byte_sent_ = false;
+  size_t peak_buffered_bytes_ = 0;
 
   mojo::ScopedDataPipeConsumerHandle body_consumer_handle_;
   mojo::ScopedDataPipeProducerHandle body_producer_handle_;
@@ -5,18 +5,17 @@
 
 #include "brave/components/weekly_storage/weekly_storage.h"
 
-#include <numeric>
+#include <algorithm>
 #include <utility>
 
+#include "base/bind.h"
 #include "base/time/clock.h"
 #include "base/time/default_clock.h"
 #include "base/values.h"
 #include "components/prefs/pref_service.h"
 #include "components/prefs/scoped_user_pref_update.h"
 
-namespace {
-constexpr size_t kDaysInWeek = 7;
-}
+constexpr size_t WeeklyStorage::kDaysInWeek;
 
 WeeklyStorage::WeeklyStorage(PrefService* prefs, const char* pref_name)
     : prefs_(prefs),
@@ -37,87 +36,98 @@ WeeklyStorage::WeeklyStorage(PrefService* prefs,
   Load();
 }
 
-WeeklyStorage::~WeeklyStorage() = default;
+WeeklyStorage::~WeeklyStorage() {
+  Flush();
+}
 
 void WeeklyStorage::AddDelta(uint64_t delta) {
   FilterToWeek();
-  daily_values_.front().value += delta;
-  Save();
+  daily_values_[today_index_].value += delta;
+  ScheduleSave();
 }
 
 void WeeklyStorage::ReplaceTodaysValueIfGreater(uint64_t value) {
   FilterToWeek();
-  DailyValue& today = daily_values_.front();
+  DailyValue& today = daily_values_[today_index_];
   if (today.value < value) {
     today.value = value;
   }
-  Save();
+  ScheduleSave();
 }
 
 uint64_t WeeklyStorage::GetWeeklySum() const {
   // We record only value for last N days.
   const base::Time n_days_ago =
       clock_->Now() - base::TimeDelta::FromDays(kDaysInWeek);
-  return std::accumulate(daily_values_.begin(), daily_values_.end(), 0ull,
-                         [n_days_ago](const uint64_t acc, const auto& u2) {
-                           uint64_t add = 0;
-                           // Check only last continious days.
-                           if (u2.day > n_days_ago) {
-                             add = u2.value;
-                           }
-                           return acc + add;
-                         });
+  uint64_t sum = 0;
+  for (size_t i = 0; i < num_days_; ++i) {
+    const DailyValue& daily_value = GetDailyValue(i);
+    // Check only last continious days.
+    if (daily_value.day > n_days_ago) {
+      sum += daily_value.value;
+    }
+  }
+  return sum;
 }
 
 uint64_t WeeklyStorage::GetHighestValueInWeek() const {
   // We record only value for last N days.
   const base::Time n_days_ago =
       clock_->Now() - base::TimeDelta::FromDays(kDaysInWeek);
-  std::list<DailyValue> last_weeks_daily_values(daily_values_.size());
-  auto copied_it =
-      std::copy_if(daily_values_.begin(), daily_values_.end(),
-                   last_weeks_daily_values.begin(),
-                   [n_days_ago](auto i) { return i.day > n_days_ago; });
-  last_weeks_daily_values.resize(
-      std::distance(last_weeks_daily_values.begin(), copied_it));
-
-  auto highest_it = std::max_element(last_weeks_daily_values.begin(),
-                                     last_weeks_daily_values.end(),
-                                     [](const auto& left, const auto& right) {
-                                       return left.value < right.value;
-                                     });
-  if (highest_it == last_weeks_daily_values.end()) {
-    return 0;
+  uint64_t highest = 0;
+  for (size_t i = 0; i < num_days_; ++i) {
+    const DailyValue& daily_value = GetDailyValue(i);
+    if (daily_value.day > n_days_ago) {
+      highest = std::max(highest, daily_value.value);
+    }
   }
-  return highest_it->value;
+  return highest;
 }
 
 bool WeeklyStorage::IsOneWeekPassed() const {
   // TODO(iefremov): This is not true 100% (if the browser was launched once
   // per week just after installation, for example).
-  return daily_values_.size() == kDaysInWeek;
+  return num_days_ == kDaysInWeek;
+}
+
+void WeeklyStorage::SetSaveDelay(base::TimeDelta delay) {
+  save_delay_ = delay;
+}
+
+void WeeklyStorage::Flush() {
+  if (!save_timer_.IsRunning()) {
+    return;
+  }
+  save_timer_.Stop();
+  Save();
+}
+
+const WeeklyStorage::DailyValue& WeeklyStorage::GetDailyValue(
+    size_t days_ago) const {
+  DCHECK_LT(days_ago, num_days_);
+  return daily_values_[(today_index_ + days_ago) % kDaysInWeek];
 }
 
 void WeeklyStorage::FilterToWeek() {
   base::Time now_midnight = clock_->Now().LocalMidnight();
   base::Time last_saved_midnight;
 
-  if (!daily_values_.empty()) {
-    last_saved_midnight = daily_values_.front().day;
+  if (num_days_ > 0) {
+    last_saved_midnight = daily_values_[today_index_].day;
   }
 
   if (now_midnight - last_saved_midnight > base::TimeDelta()) {
     // Day changed. Since we consider only small incoming intervals, lets just
-    // save it with a new timestamp.
-    daily_values_.push_front({now_midnight, 0});
-    if (daily_values_.size() > kDaysInWeek) {
-      daily_values_.pop_back();
-    }
+    // save it with a new timestamp, overwriting the oldest day if the week is
+    // full.
+    today_index_ = (today_index_ + kDaysInWeek - 1) % kDaysInWeek;
+    daily_values_[today_index_] = {now_midnight, 0};
+    num_days_ = std::min(num_days_ + 1, kDaysInWeek);
   }
 }
 
 void WeeklyStorage::Load() {
-  DCHECK(daily_values_.empty());
+  DCHECK_EQ(num_days_, 0u);
   const base::ListValue* list = prefs_->GetList(pref_name_);
   if (!list) {
     return;
@@ -128,26 +138,40 @@ void WeeklyStorage::Load() {
     if (!day || !value || !day->is_double() || !value->is_double()) {
       continue;
     }
-    if (daily_values_.size() == kDaysInWeek) {
+    if (num_days_ == kDaysInWeek) {
       break;
     }
-    daily_values_.push_back({base::Time::FromDoubleT(day->GetDouble()),
-                             static_cast<uint64_t>(value->GetDouble())});
+    daily_values_[num_days_++] = {base::Time::FromDoubleT(day->GetDouble()),
+                                  static_cast<uint64_t>(value->GetDouble())};
   }
 }
 
 void WeeklyStorage::Save() {
-  DCHECK(!daily_values_.empty());
-  DCHECK_LE(daily_values_.size(), kDaysInWeek);
+  DCHECK_GT(num_days_, 0u);
+  DCHECK_LE(num_days_, kDaysInWeek);
 
   ListPrefUpdate update(prefs_, pref_name_);
   base::ListValue* list = update.Get();
-  // TODO(iefremov): Optimize if needed.
   list->Clear();
-  for (const auto& u : daily_values_) {
+  for (size_t i = 0; i < num_days_; ++i) {
+    const DailyValue& daily_value = GetDailyValue(i);
     base::DictionaryValue value;
-    value.SetKey("day", base::Value(u.day.ToDoubleT()));
-    value.SetDoubleKey("value", u.value);
+    value.SetKey("day", base::Value(daily_value.day.ToDoubleT()));
+    value.SetDoubleKey("value", daily_value.value);
     list->Append(std::move(value));
   }
 }
+
+void WeeklyStorage::ScheduleSave() {
+  if (save_delay_.is_zero()) {
+    Save();
+    return;
+  }
+
+  if (!save_timer_.IsRunning()) {
+    // base::Unretained is safe because |save_timer_| is owned by this.
+    save_timer_.Start(FROM_HERE, save_delay_,
+                      base::BindOnce(&WeeklyStorage::Save,
+                                     base::Unretained(this)));
+  }
+}
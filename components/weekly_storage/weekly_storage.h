@@ -6,10 +6,11 @@
 #ifndef BRAVE_COMPONENTS_WEEKLY_STORAGE_WEEKLY_STORAGE_H_
 #define BRAVE_COMPONENTS_WEEKLY_STORAGE_WEEKLY_STORAGE_H_
 
-#include <list>
+#include <array>
 #include <memory>
 
 #include "base/time/time.h"
+#include "base/timer/timer.h"
 
 namespace base {
 class Clock;
@@ -41,20 +42,38 @@ class WeeklyStorage {
   uint64_t GetHighestValueInWeek() const;
   bool IsOneWeekPassed() const;
 
+  // Coalesces writes to the pref store so that values are saved at most once
+  // per |delay| rather than on every update. Pending values are saved by
+  // |Flush| or on destruction.
+  void SetSaveDelay(base::TimeDelta delay);
+  void Flush();
+
  private:
+  static constexpr size_t kDaysInWeek = 7;
+
   struct DailyValue {
     base::Time day;
     uint64_t value = 0ull;
   };
+  // |days_ago| is relative to the most recently recorded day.
+  const DailyValue& GetDailyValue(size_t days_ago) const;
   void FilterToWeek();
   void Load();
   void Save();
+  void ScheduleSave();
 
   PrefService* prefs_ = nullptr;
   const char* pref_name_ = nullptr;
   std::unique_ptr<base::Clock> clock_;
 
-  std::list<DailyValue> daily_values_;
+  // Ring buffer of the last |num_days_| daily values, the most recent day is
+  // at |today_index_|.
+  std::array<DailyValue, kDaysInWeek> daily_values_;
+  size_t today_index_ = 0;
+  size_t num_days_ = 0;
+
+  base::TimeDelta save_delay_;
+  base::OneShotTimer save_timer_;
 };
 
 #endif  // BRAVE_COMPONENTS_WEEKLY_STORAGE_WEEKLY_STORAGE_H_
@@ -0,0 +1,49 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/weekly_storage/weekly_storage_registry.h"
+
+#include "base/time/time.h"
+#include "brave/components/weekly_storage/weekly_storage.h"
+#include "components/prefs/pref_service.h"
+
+namespace {
+constexpr int kSaveDelayInSeconds = 10;
+}  // namespace
+
+WeeklyStorageRegistry::WeeklyStorageRegistry(PrefService* prefs)
+    : prefs_(prefs) {
+  DCHECK(prefs);
+}
+
+WeeklyStorageRegistry::~WeeklyStorageRegistry() = default;
+
+WeeklyStorage* WeeklyStorageRegistry::Get(const std::string& pref_name) {
+  auto iter = storages_.find(pref_name);
+  if (iter != storages_.end()) {
+    return iter->second.get();
+  }
+
+  if (!prefs_->FindPreference(pref_name)) {
+    return nullptr;
+  }
+
+  // The map key outlives the storage, so it is safe to pass its c_str().
+  iter = storages_.emplace(pref_name, nullptr).first;
+  iter->second = std::make_unique<WeeklyStorage>(prefs_, iter->first.c_str());
+  iter->second->SetSaveDelay(base::TimeDelta::FromSeconds(kSaveDelayInSeconds));
+  return iter->second.get();
+}
+
+void WeeklyStorageRegistry::Flush() {
+  for (auto& storage : storages_) {
+    storage.second->Flush();
+  }
+}
+
+void WeeklyStorageRegistry::Shutdown() {
+  Flush();
+  storages_.clear();
+}
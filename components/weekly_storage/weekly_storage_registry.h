@@ -0,0 +1,44 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_WEEKLY_STORAGE_WEEKLY_STORAGE_REGISTRY_H_
+#define BRAVE_COMPONENTS_WEEKLY_STORAGE_WEEKLY_STORAGE_REGISTRY_H_
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include "components/keyed_service/core/keyed_service.h"
+
+class PrefService;
+class WeeklyStorage;
+
+// Keeps one long-lived |WeeklyStorage| per pref so that frequently updated
+// counters are read from prefs once and written back to prefs in batches,
+// rather than loading and saving the whole list on every update.
+class WeeklyStorageRegistry : public KeyedService {
+ public:
+  explicit WeeklyStorageRegistry(PrefService* prefs);
+  ~WeeklyStorageRegistry() override;
+
+  WeeklyStorageRegistry(const WeeklyStorageRegistry&) = delete;
+  WeeklyStorageRegistry& operator=(const WeeklyStorageRegistry&) = delete;
+
+  // Returns the storage for |pref_name| or nullptr if the pref is not
+  // registered.
+  WeeklyStorage* Get(const std::string& pref_name);
+
+  // Saves pending values of all storages.
+  void Flush();
+
+  // KeyedService:
+  void Shutdown() override;
+
+ private:
+  PrefService* prefs_ = nullptr;
+  std::map<std::string, std::unique_ptr<WeeklyStorage>> storages_;
+};
+
+#endif  // BRAVE_COMPONENTS_WEEKLY_STORAGE_WEEKLY_STORAGE_REGISTRY_H_
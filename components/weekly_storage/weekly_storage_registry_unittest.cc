@@ -0,0 +1,64 @@
+/* Copyright (c) 2021 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/weekly_storage/weekly_storage_registry.h"
+
+#include "base/test/task_environment.h"
+#include "base/values.h"
+#include "brave/components/weekly_storage/weekly_storage.h"
+#include "components/prefs/pref_registry_simple.h"
+#include "components/prefs/testing_pref_service.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+constexpr char kPrefName[] = "brave.weekly_registry_test";
+}  // namespace
+
+class WeeklyStorageRegistryTest : public ::testing::Test {
+ public:
+  WeeklyStorageRegistryTest() : registry_(&pref_service_) {
+    pref_service_.registry()->RegisterListPref(kPrefName);
+  }
+
+ protected:
+  size_t GetSavedDaysCount() {
+    return pref_service_.GetList(kPrefName)->GetList().size();
+  }
+
+  base::test::TaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+  TestingPrefServiceSimple pref_service_;
+  WeeklyStorageRegistry registry_;
+};
+
+TEST_F(WeeklyStorageRegistryTest, ReturnsNullForUnregisteredPref) {
+  EXPECT_EQ(registry_.Get("brave.unregistered"), nullptr);
+}
+
+TEST_F(WeeklyStorageRegistryTest, ReturnsSameStorageForPref) {
+  WeeklyStorage* storage = registry_.Get(kPrefName);
+  ASSERT_TRUE(storage);
+  storage->AddDelta(10);
+
+  EXPECT_EQ(registry_.Get(kPrefName), storage);
+  EXPECT_EQ(registry_.Get(kPrefName)->GetWeeklySum(), 10ULL);
+}
+
+TEST_F(WeeklyStorageRegistryTest, CoalescesSaves) {
+  registry_.Get(kPrefName)->AddDelta(10);
+  registry_.Get(kPrefName)->AddDelta(10);
+  EXPECT_EQ(GetSavedDaysCount(), 0UL);
+
+  task_environment_.FastForwardUntilNoTasksRemain();
+  EXPECT_EQ(GetSavedDaysCount(), 1UL);
+}
+
+TEST_F(WeeklyStorageRegistryTest, SavesPendingValuesOnShutdown) {
+  registry_.Get(kPrefName)->AddDelta(10);
+  EXPECT_EQ(GetSavedDaysCount(), 0UL);
+
+  registry_.Shutdown();
+  EXPECT_EQ(GetSavedDaysCount(), 1UL);
+}
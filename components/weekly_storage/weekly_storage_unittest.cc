@@ -9,15 +9,20 @@
 #include <utility>
 
 #include "base/test/simple_test_clock.h"
+#include "base/test/task_environment.h"
 #include "base/time/time.h"
+#include "base/values.h"
 #include "components/prefs/pref_registry_simple.h"
 #include "components/prefs/testing_pref_service.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
+namespace {
+constexpr char kPrefName[] = "brave.weekly_test";
+}  // namespace
+
 class WeeklyStorageTest : public ::testing::Test {
  public:
   WeeklyStorageTest() : clock_(new base::SimpleTestClock) {
-    constexpr char kPrefName[] = "brave.weekly_test";
     pref_service_.registry()->RegisterListPref(kPrefName);
 
     state_ = std::make_unique<WeeklyStorage>(
@@ -26,6 +31,8 @@ class WeeklyStorageTest : public ::testing::Test {
   }
 
  protected:
+  base::test::TaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
   base::SimpleTestClock* clock_;
   TestingPrefServiceSimple pref_service_;
   std::unique_ptr<WeeklyStorage> state_;
@@ -138,3 +145,38 @@ TEST_F(WeeklyStorageTest, GetsHighestValueInWeekFromReplacement) {
   // Sanity check disparate days were not replaced
   EXPECT_EQ(state_->GetWeeklySum(), high_value + low_value);
 }
+
+TEST_F(WeeklyStorageTest, KeepsLastWeekAfterManyDays) {
+  for (uint64_t day = 1; day <= 10; day++) {
+    clock_->Advance(base::TimeDelta::FromDays(1));
+    state_->AddDelta(day);
+  }
+  EXPECT_TRUE(state_->IsOneWeekPassed());
+  EXPECT_EQ(state_->GetHighestValueInWeek(), 10ULL);
+  // Only the last 6 full days and today are within the week.
+  EXPECT_EQ(state_->GetWeeklySum(), 4ULL + 5 + 6 + 7 + 8 + 9 + 10);
+  EXPECT_EQ(pref_service_.GetList(kPrefName)->GetList().size(), 7UL);
+}
+
+TEST_F(WeeklyStorageTest, CoalescesSaves) {
+  state_->SetSaveDelay(base::TimeDelta::FromSeconds(10));
+  state_->AddDelta(10);
+  state_->AddDelta(20);
+  EXPECT_EQ(state_->GetWeeklySum(), 30ULL);
+  EXPECT_TRUE(pref_service_.GetList(kPrefName)->GetList().empty());
+
+  task_environment_.FastForwardBy(base::TimeDelta::FromSeconds(10));
+  auto clock = std::make_unique<base::SimpleTestClock>();
+  clock->SetNow(clock_->Now());
+  WeeklyStorage loaded(&pref_service_, kPrefName, std::move(clock));
+  EXPECT_EQ(loaded.GetWeeklySum(), 30ULL);
+}
+
+TEST_F(WeeklyStorageTest, SavesPendingValuesOnDestruction) {
+  state_->SetSaveDelay(base::TimeDelta::FromSeconds(10));
+  state_->AddDelta(10);
+  EXPECT_TRUE(pref_service_.GetList(kPrefName)->GetList().empty());
+
+  state_.reset();
+  EXPECT_EQ(pref_service_.GetList(kPrefName)->GetList().size(), 1UL);
+}
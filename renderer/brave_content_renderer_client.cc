@@ -6,6 +6,7 @@
 #include "brave/renderer/brave_content_renderer_client.h"
 
 #include "base/feature_list.h"
+#include "brave/components/brave_ads/renderer/page_content_extractor.h"
 #include "brave/components/brave_shields/common/features.h"
 #include "brave/components/brave_wallet/common/buildflags/buildflags.h"
 #include "brave/components/cosmetic_filters/renderer/cosmetic_filters_js_render_frame_observer.h"
@@ -61,6 +62,10 @@ void BraveContentRendererClient::RenderFrameCreated(
     new cosmetic_filters::CosmeticFiltersJsRenderFrameObserver(
         render_frame, ISOLATED_WORLD_ID_BRAVE_INTERNAL);
 
+  if (render_frame->IsMainFrame()) {
+    new brave_ads::PageContentExtractor(render_frame);
+  }
+
 #if BUILDFLAG(BRAVE_WALLET_ENABLED)
   if (base::FeatureList::IsEnabled(
           brave_wallet::features::kNativeBraveWalletFeature)) {